@@ -0,0 +1,414 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "DoublyLinkedList.h"
+#include "ListMemory.h"
+
+// List that picks its own layout. Elements live either in a std::vector
+// (Contiguous) or in a DoublyLinkedList (Linked), and the list switches
+// between the two at run time according to the operations it sees.
+//
+// Every operation charges a modelled cost to both layouts: what it cost
+// in the layout in use and what it would have cost in the other one, in
+// units of one dependent pointer load. Indexed access and scans are cheap
+// contiguous and a walk when linked; inserts and erases away from the back
+// are an element shift contiguous and an allocation plus a walk to the
+// position when linked (the list's finger makes nearby positions cheap).
+// Every kEpochOps operations the saving the other layout would have
+// brought is folded into a decaying balance, and the list migrates once
+// that balance exceeds kHysteresis times the cost of migrating (one node
+// allocation and copy per element). The decay and the margin keep a short
+// burst or an evenly mixed trace from making the list flip back and forth.
+//
+// pin() forces a layout and stops adaptation until unpin(). Positions
+// rather than iterators are the currency: a migration would invalidate
+// iterators, so the interface is index-based plus for_each()/to_vector().
+enum class ListRepresentation { Contiguous, Linked };
+
+template <typename T>
+class AdaptiveList {
+public:
+    using Representation = ListRepresentation;
+
+    // Modelled costs, in dependent loads.
+    static constexpr double kLinkStep = 1.0;      // following one link
+    static constexpr double kSeqRead = 0.125;     // one element of a contiguous scan
+    // Moving one element inside the vector: a memmove share for trivially
+    // copyable T, a move constructor call otherwise.
+    static constexpr double kShift =
+        std::is_trivially_copyable<T>::value ? static_cast<double>(sizeof(T)) / 256.0 : 1.0;
+    static constexpr double kNodeAlloc = 16.0;    // allocating or freeing a node
+    static constexpr size_t kEpochOps = 128;
+    static constexpr double kDecay = 0.97;
+    static constexpr double kHysteresis = 1.5;
+
+private:
+    Representation rep;
+    bool pinned;
+    std::vector<T> vec;
+    DoublyLinkedList<T> list;
+
+    // Profile of the current epoch; mutable so that const reads count.
+    mutable double costContiguous;
+    mutable double costLinked;
+    mutable size_t epochOps;
+    mutable size_t lastIndex;   // mirrors the linked list's finger
+    double balance;             // decayed saving of the other layout
+    size_t migrationCount;
+
+    size_t n() const { return rep == Representation::Contiguous ? vec.size() : list.size(); }
+
+    // Links from the nearest of head, tail or the last indexed position.
+    size_t walk(size_t index) const {
+        size_t size = n();
+        size_t steps = std::min(index, index < size ? size - 1 - index : 0);
+        size_t fromFinger = index > lastIndex ? index - lastIndex : lastIndex - index;
+        lastIndex = index;
+        return std::min(steps, fromFinger);
+    }
+
+    void note(double contiguous, double linked) const {
+        costContiguous += contiguous;
+        costLinked += linked;
+        ++epochOps;
+    }
+
+    void noteIndexed(size_t index) const { note(1.0, kLinkStep * walk(index)); }
+
+    void noteScan() const {
+        double size = static_cast<double>(n());
+        note(kSeqRead * size + 1.0, kLinkStep * size + 1.0);
+    }
+
+    void noteEdit(size_t index) const {
+        double shifted = static_cast<double>(n() - std::min(index, n()));
+        note(kShift * shifted + 1.0, kLinkStep * walk(index) + kNodeAlloc);
+    }
+
+    // Called by the non-const operations after they ran: closes an epoch
+    // and migrates if the balance says so.
+    void adapt() {
+        if (epochOps < kEpochOps) return;
+        double here = rep == Representation::Contiguous ? costContiguous : costLinked;
+        double there = rep == Representation::Contiguous ? costLinked : costContiguous;
+        balance = std::max(0.0, balance * kDecay + (here - there));
+        costContiguous = costLinked = 0;
+        epochOps = 0;
+        if (pinned) return;
+        double migration = static_cast<double>(n()) * (kNodeAlloc + kLinkStep) + kNodeAlloc;
+        if (balance > kHysteresis * migration) {
+            migrate(rep == Representation::Contiguous ? Representation::Linked : Representation::Contiguous);
+        }
+    }
+
+    // Builds the new layout on the side, so a throwing allocation or copy
+    // leaves the list as it was: elements are moved only once everything
+    // that can throw is done. Going linked, every node is allocated (holding
+    // T()) before the first element is moved in; when T cannot be default
+    // constructed and move assigned without throwing, the elements are
+    // copied instead. A T that is neither is moved node by node, and a
+    // failed allocation then loses the elements moved so far.
+    void migrate(Representation to) {
+        if (to == rep) return;
+        if (to == Representation::Linked) {
+            DoublyLinkedList<T> built;
+            if constexpr (std::is_nothrow_default_constructible<T>::value &&
+                          std::is_nothrow_move_assignable<T>::value) {
+                for (size_t i = 0; i < vec.size(); ++i) built.emplace_back();
+                auto it = built.begin();
+                for (auto& v : vec) *it++ = std::move(v);
+            } else if constexpr (std::is_copy_constructible<T>::value) {
+                for (const auto& v : vec) built.push_back(v);
+            } else {
+                for (auto& v : vec) built.push_back(std::move(v));
+            }
+            list = std::move(built);
+            std::vector<T>().swap(vec);
+        } else {
+            std::vector<T> built;
+            built.reserve(list.size());
+            for (auto& v : list) built.push_back(std::move_if_noexcept(v));
+            vec = std::move(built);
+            list.clear();
+        }
+        rep = to;
+        balance = 0;
+        ++migrationCount;
+    }
+
+    typename DoublyLinkedList<T>::const_iterator linkedAt(size_t index) const {
+        auto it = list.cbegin();
+        std::advance(it, static_cast<std::ptrdiff_t>(index));
+        return it;
+    }
+
+public:
+    explicit AdaptiveList(Representation initial = Representation::Contiguous)
+        : rep(initial), pinned(false), costContiguous(0), costLinked(0), epochOps(0), lastIndex(0), balance(0),
+          migrationCount(0) {}
+
+    AdaptiveList(std::initializer_list<T> init) : AdaptiveList() {
+        vec.assign(init.begin(), init.end());
+    }
+
+    Representation representation() const { return rep; }
+    bool is_pinned() const { return pinned; }
+    // Number of layout switches so far, pin() included.
+    size_t migrations() const { return migrationCount; }
+
+    // Moves to layout r now and keeps it until unpin().
+    void pin(Representation r) {
+        migrate(r);
+        pinned = true;
+    }
+
+    void unpin() {
+        pinned = false;
+        balance = 0;
+    }
+
+    bool empty() const { return n() == 0; }
+    size_t size() const { return n(); }
+
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m = list.memory_usage();
+        m.live_bytes += vec.size() * sizeof(T);
+        list_memory::add_vector_buffer(m, vec.size(), vec.capacity(), sizeof(T));
+        m.overhead_bytes += sizeof(*this) - sizeof(list);
+        return m;
+    }
+
+    // Element access
+
+    T& front() {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return rep == Representation::Contiguous ? vec.front() : list.front();
+    }
+
+    const T& front() const {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return rep == Representation::Contiguous ? vec.front() : list.front();
+    }
+
+    T& back() {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        return rep == Representation::Contiguous ? vec.back() : list.back();
+    }
+
+    const T& back() const {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        return rep == Representation::Contiguous ? vec.back() : list.back();
+    }
+
+    T& at(size_t index) {
+        if (index >= n()) throw std::out_of_range("at: index out of range");
+        noteIndexed(index);
+        adapt();
+        return rep == Representation::Contiguous ? vec[index] : list.at(index);
+    }
+
+    const T& at(size_t index) const {
+        if (index >= n()) throw std::out_of_range("at: index out of range");
+        noteIndexed(index);
+        return rep == Representation::Contiguous ? vec[index] : list.at(index);
+    }
+
+    T& operator[](size_t index) { return at(index); }
+    const T& operator[](size_t index) const { return at(index); }
+
+    // Modifiers
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        note(1.0, kNodeAlloc);
+        if (rep == Representation::Contiguous) vec.emplace_back(std::forward<Args>(args)...);
+        else list.emplace_back(std::forward<Args>(args)...);
+        adapt();
+    }
+
+    template <typename... Args>
+    void emplace_front(Args&&... args) {
+        noteEdit(0);
+        if (rep == Representation::Contiguous) vec.emplace(vec.begin(), std::forward<Args>(args)...);
+        else list.emplace_front(std::forward<Args>(args)...);
+        adapt();
+    }
+
+    bool pop_back() {
+        if (empty()) return false;
+        note(1.0, kNodeAlloc);
+        if (rep == Representation::Contiguous) vec.pop_back();
+        else list.pop_back();
+        adapt();
+        return true;
+    }
+
+    bool pop_front() {
+        if (empty()) return false;
+        noteEdit(0);
+        if (rep == Representation::Contiguous) vec.erase(vec.begin());
+        else list.pop_front();
+        adapt();
+        return true;
+    }
+
+    bool insert_at(size_t index, const T& value) {
+        if (index > n()) return false;
+        noteEdit(index);
+        if (rep == Representation::Contiguous) vec.insert(vec.begin() + static_cast<std::ptrdiff_t>(index), value);
+        else list.insert_at(index, value);
+        adapt();
+        return true;
+    }
+
+    bool insert_at(size_t index, T&& value) {
+        if (index > n()) return false;
+        noteEdit(index);
+        if (rep == Representation::Contiguous) {
+            vec.insert(vec.begin() + static_cast<std::ptrdiff_t>(index), std::move(value));
+        } else {
+            list.insert_at(index, std::move(value));
+        }
+        adapt();
+        return true;
+    }
+
+    bool erase_at(size_t index) {
+        if (index >= n()) return false;
+        noteEdit(index);
+        if (rep == Representation::Contiguous) vec.erase(vec.begin() + static_cast<std::ptrdiff_t>(index));
+        else list.erase_at(index);
+        adapt();
+        return true;
+    }
+
+    int remove_all(const T& value) {
+        return static_cast<int>(erase_if([&value](const T& v) { return v == value; }));
+    }
+
+    template <typename Pred>
+    size_t erase_if(Pred pred) {
+        noteScan();
+        size_t removed;
+        if (rep == Representation::Contiguous) {
+            auto it = std::remove_if(vec.begin(), vec.end(), pred);
+            removed = static_cast<size_t>(vec.end() - it);
+            vec.erase(it, vec.end());
+        } else {
+            removed = list.erase_if(pred);
+        }
+        adapt();
+        return removed;
+    }
+
+    void clear() {
+        vec.clear();
+        list.clear();
+    }
+
+    void sort_ascending() { sortBy(std::less<T>()); }
+    void sort_descending() { sortBy(std::greater<T>()); }
+
+    void reverse() {
+        note(kShift * static_cast<double>(n()), 1.0);
+        if (rep == Representation::Contiguous) std::reverse(vec.begin(), vec.end());
+        else list.reverse();
+        adapt();
+    }
+
+    // Moves all of other's elements in front of position index (size()
+    // appends); other is left empty. O(1) after the walk when both lists
+    // are linked.
+    void splice(size_t index, AdaptiveList& other) {
+        if (this == &other || other.empty()) return;
+        if (index > n()) throw std::out_of_range("splice: index out of range");
+        double m = static_cast<double>(other.size());
+        double tail = static_cast<double>(n() - index);
+        bool otherLinked = other.rep == Representation::Linked;
+        note(kShift * (tail + m) + m, kLinkStep * walk(index) + (otherLinked ? 1.0 : m * kNodeAlloc));
+        if (rep == Representation::Linked && otherLinked) {
+            list.splice(linkedAt(index), other.list);
+        } else if (rep == Representation::Linked) {
+            DoublyLinkedList<T> moved;
+            for (auto& v : other.vec) moved.push_back(std::move(v));
+            list.splice(linkedAt(index), moved);
+        } else if (otherLinked) {
+            vec.insert(vec.begin() + static_cast<std::ptrdiff_t>(index), std::make_move_iterator(other.list.begin()),
+                       std::make_move_iterator(other.list.end()));
+        } else {
+            vec.insert(vec.begin() + static_cast<std::ptrdiff_t>(index), std::make_move_iterator(other.vec.begin()),
+                       std::make_move_iterator(other.vec.end()));
+        }
+        other.clear();
+        adapt();
+    }
+
+    // Queries
+
+    bool contains(const T& value) const { return find_first_index(value) >= 0; }
+
+    int find_first_index(const T& value) const {
+        noteScan();
+        if (rep == Representation::Linked) return list.find_first_index(value);
+        auto it = std::find(vec.begin(), vec.end(), value);
+        return it == vec.end() ? -1 : static_cast<int>(it - vec.begin());
+    }
+
+    template <typename F>
+    void for_each(F f) const {
+        noteScan();
+        if (rep == Representation::Contiguous) {
+            for (const auto& v : vec) f(v);
+        } else {
+            for (const auto& v : list) f(v);
+        }
+    }
+
+    std::vector<T> to_vector() const {
+        if (rep == Representation::Contiguous) return vec;
+        return list.to_vector();
+    }
+
+private:
+    template <typename Compare>
+    void sortBy(Compare comp) {
+        double size = static_cast<double>(n());
+        double sortCost = size > 1 ? size * std::log2(size) : 0.0;
+        // DoublyLinkedList sorts through a vector: one copy out, one rebuild.
+        note(sortCost, sortCost + size * (kSeqRead + kNodeAlloc));
+        if (rep == Representation::Contiguous) {
+            std::sort(vec.begin(), vec.end(), comp);
+        } else if constexpr (std::is_same<Compare, std::less<T>>::value) {
+            list.sort_ascending();
+        } else {
+            list.sort_descending();
+        }
+        adapt();
+    }
+};
+
+template <typename T>
+bool operator==(const AdaptiveList<T>& lhs, const AdaptiveList<T>& rhs) {
+    return lhs.size() == rhs.size() && lhs.to_vector() == rhs.to_vector();
+}
+
+template <typename T>
+bool operator!=(const AdaptiveList<T>& lhs, const AdaptiveList<T>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,422 @@
+#pragma once
+
+#if !defined(__cpp_impl_coroutine)
+#error "AsyncListChannel.h requires C++20 coroutines (-std=c++20)"
+#endif
+
+#include <algorithm>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "DoublyLinkedList.h"
+
+// Bounded multi-producer / multi-consumer channel for coroutines, backed by a
+// DoublyLinkedList. A consumer that finds the channel empty suspends instead
+// of polling, and a producer that finds it full suspends until a consumer
+// makes room. Suspended coroutines are resumed by posting them to the
+// channel's executor, never inline, so a long pipeline does not grow the
+// stack.
+//
+//     SingleThreadExecutor ex;
+//     AsyncListChannel<int> ch(ex, 64);
+//     spawn(ex, [&]() -> ChannelTask { co_await ch.push(1); ch.close(); co_return; }());
+//     spawn(ex, [&]() -> ChannelTask { while (auto v = co_await ch.pop()) use(*v); }());
+//     ex.run();
+
+class ChannelExecutor {
+public:
+    virtual ~ChannelExecutor() = default;
+    virtual void post(std::coroutine_handle<> h) = 0;
+};
+
+// Runs posted coroutines on the thread that calls run(). post() may be
+// called from any thread.
+class SingleThreadExecutor : public ChannelExecutor {
+public:
+    void post(std::coroutine_handle<> h) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.push_back(h);
+    }
+
+    // Resumes one ready coroutine; returns false if none was ready.
+    bool run_one() {
+        std::coroutine_handle<> h;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ready.empty()) return false;
+            h = ready.front();
+            ready.pop_front();
+        }
+        h.resume();
+        return true;
+    }
+
+    // Resumes coroutines until none is ready. Returns how many were resumed.
+    size_t run() {
+        size_t n = 0;
+        while (run_one()) ++n;
+        return n;
+    }
+
+private:
+    std::mutex mutex;
+    std::deque<std::coroutine_handle<>> ready;
+};
+
+// Fixed-size pool of worker threads sharing one ready queue.
+class ThreadPoolExecutor : public ChannelExecutor {
+public:
+    explicit ThreadPoolExecutor(unsigned threads = std::thread::hardware_concurrency()) {
+        if (threads == 0) threads = 1;
+        workers.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    // Finishes the coroutines already queued, then joins the workers.
+    ~ThreadPoolExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    void post(std::coroutine_handle<> h) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.push_back(h);
+        }
+        wake.notify_one();
+    }
+
+    size_t thread_count() const { return workers.size(); }
+
+private:
+    void workerLoop() {
+        for (;;) {
+            std::coroutine_handle<> h;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !ready.empty(); });
+                if (ready.empty()) return;
+                h = ready.front();
+                ready.pop_front();
+            }
+            h.resume();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::coroutine_handle<>> ready;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+};
+
+// Fire-and-forget coroutine type. The body does not start until spawn()
+// posts it, and the frame frees itself when the body returns.
+class ChannelTask {
+public:
+    struct promise_type {
+        ChannelTask get_return_object() {
+            return ChannelTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    ChannelTask(ChannelTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    ChannelTask(const ChannelTask&) = delete;
+    ChannelTask& operator=(const ChannelTask&) = delete;
+
+    ~ChannelTask() {
+        if (handle) handle.destroy();
+    }
+
+private:
+    friend void spawn(ChannelExecutor& ex, ChannelTask task);
+
+    explicit ChannelTask(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+inline void spawn(ChannelExecutor& ex, ChannelTask task) {
+    ex.post(std::exchange(task.handle, nullptr));
+}
+
+template <typename T>
+class AsyncListChannel {
+    // Suspended consumer. A producer hands values straight into `received`
+    // so the consumer cannot lose them to another consumer before it runs.
+    struct PopWaiter {
+        std::coroutine_handle<> handle;
+        size_t want;
+        DoublyLinkedList<T> received;
+        PopWaiter* next = nullptr;
+    };
+
+    // Suspended producer, holding the value it could not enqueue yet.
+    struct PushWaiter {
+        std::coroutine_handle<> handle;
+        std::optional<T> value;
+        bool accepted = false;
+        PushWaiter* next = nullptr;
+    };
+
+    template <typename W>
+    struct WaitQueue {
+        W* first = nullptr;
+        W* last = nullptr;
+
+        bool empty() const { return first == nullptr; }
+
+        void push(W* w) {
+            w->next = nullptr;
+            if (last) last->next = w;
+            else first = w;
+            last = w;
+        }
+
+        W* pop() {
+            W* w = first;
+            first = w->next;
+            if (!first) last = nullptr;
+            return w;
+        }
+    };
+
+public:
+    class PushAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> h) {
+            waiter.handle = h;
+            return channel.suspendPush(waiter);
+        }
+
+        // True if the value entered the channel, false if it was closed.
+        bool await_resume() const noexcept { return waiter.accepted; }
+
+    private:
+        friend class AsyncListChannel;
+
+        PushAwaiter(AsyncListChannel& ch, T&& value) : channel(ch) { waiter.value.emplace(std::move(value)); }
+
+        AsyncListChannel& channel;
+        PushWaiter waiter;
+    };
+
+    class PopNAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> h) {
+            waiter.handle = h;
+            return channel.suspendPop(waiter);
+        }
+
+        // Between 1 and k values; empty only once the channel is closed and drained.
+        DoublyLinkedList<T> await_resume() { return std::move(waiter.received); }
+
+    private:
+        friend class AsyncListChannel;
+
+        PopNAwaiter(AsyncListChannel& ch, size_t k) : channel(ch) { waiter.want = k; }
+
+        AsyncListChannel& channel;
+        PopWaiter waiter;
+    };
+
+    class PopAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> h) {
+            waiter.handle = h;
+            return channel.suspendPop(waiter);
+        }
+
+        // The next value, or nullopt once the channel is closed and drained.
+        std::optional<T> await_resume() {
+            if (waiter.received.empty()) return std::nullopt;
+            return std::optional<T>(std::move(waiter.received.front()));
+        }
+
+    private:
+        friend class AsyncListChannel;
+
+        PopAwaiter(AsyncListChannel& ch) : channel(ch) { waiter.want = 1; }
+
+        AsyncListChannel& channel;
+        PopWaiter waiter;
+    };
+
+    AsyncListChannel(ChannelExecutor& ex, size_t capacity) : executor(ex), cap(capacity) {
+        if (capacity == 0) throw std::invalid_argument("AsyncListChannel: capacity must be positive");
+    }
+
+    AsyncListChannel(const AsyncListChannel&) = delete;
+    AsyncListChannel& operator=(const AsyncListChannel&) = delete;
+
+    // co_await push(v): suspends while the channel is full.
+    PushAwaiter push(T value) { return PushAwaiter(*this, std::move(value)); }
+
+    // co_await pop(): suspends while the channel is empty.
+    PopAwaiter pop() { return PopAwaiter(*this); }
+
+    // co_await pop_n(k): takes up to k queued values in one splice,
+    // suspending only if none is queued.
+    PopNAwaiter pop_n(size_t k) {
+        if (k == 0) throw std::invalid_argument("pop_n: k must be positive");
+        return PopNAwaiter(*this, k);
+    }
+
+    // Non-suspending variants for callers outside a coroutine.
+    bool try_push(T value) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (closed) return false;
+        if (!poppers.empty()) {
+            PopWaiter* w = poppers.pop();
+            w->received.push_back(std::move(value));
+            lock.unlock();
+            executor.post(w->handle);
+            return true;
+        }
+        if (items.size() >= cap) return false;
+        items.push_back(std::move(value));
+        return true;
+    }
+
+    std::optional<T> try_pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (items.empty()) return std::nullopt;
+        std::optional<T> out(std::move(items.front()));
+        items.pop_front();
+        PushWaiter* refilled = refillFromPushers(1);
+        lock.unlock();
+        postAll(refilled);
+        return out;
+    }
+
+    // Wakes every suspended consumer (they receive nullopt / an empty batch
+    // once the queue drains) and every suspended producer (push yields false).
+    void close() {
+        PopWaiter* pops;
+        PushWaiter* pushes;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (closed) return;
+            closed = true;
+            pops = poppers.first;
+            pushes = pushers.first;
+            poppers = {};
+            pushers = {};
+        }
+        while (pops) {
+            PopWaiter* nxt = pops->next;
+            executor.post(pops->handle);
+            pops = nxt;
+        }
+        postAll(pushes);
+    }
+
+    bool is_closed() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return closed;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.size();
+    }
+
+    size_t capacity() const { return cap; }
+
+private:
+    // Returns false if the push completed without suspending.
+    bool suspendPush(PushWaiter& w) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (closed) return false;
+        if (!poppers.empty()) {
+            PopWaiter* p = poppers.pop();
+            p->received.push_back(std::move(*w.value));
+            w.accepted = true;
+            lock.unlock();
+            executor.post(p->handle);
+            return false;
+        }
+        if (items.size() < cap) {
+            items.push_back(std::move(*w.value));
+            w.accepted = true;
+            return false;
+        }
+        pushers.push(&w);
+        return true;
+    }
+
+    // Returns false if values (or the closed state) were available at once.
+    bool suspendPop(PopWaiter& w) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (items.empty()) {
+            if (closed) return false;
+            poppers.push(&w);
+            return true;
+        }
+        size_t taken = std::min(w.want, items.size());
+        w.received = items.take_front(taken);
+        PushWaiter* refilled = refillFromPushers(taken);
+        lock.unlock();
+        postAll(refilled);
+        return false;
+    }
+
+    // Moves up to n blocked producers' values into the freed space and
+    // returns them as a chain to resume once the lock is dropped.
+    PushWaiter* refillFromPushers(size_t n) {
+        PushWaiter* chain = nullptr;
+        PushWaiter** tailLink = &chain;
+        while (n-- > 0 && !pushers.empty() && items.size() < cap) {
+            PushWaiter* w = pushers.pop();
+            items.push_back(std::move(*w->value));
+            w->accepted = true;
+            *tailLink = w;
+            tailLink = &w->next;
+        }
+        *tailLink = nullptr;
+        return chain;
+    }
+
+    void postAll(PushWaiter* chain) {
+        while (chain) {
+            // Read next first: once posted the waiter's frame may resume and go away.
+            PushWaiter* nxt = chain->next;
+            executor.post(chain->handle);
+            chain = nxt;
+        }
+    }
+
+    ChannelExecutor& executor;
+    const size_t cap;
+    mutable std::mutex mutex;
+    DoublyLinkedList<T> items;
+    WaitQueue<PopWaiter> poppers;
+    WaitQueue<PushWaiter> pushers;
+    bool closed = false;
+};
@@ -0,0 +1,451 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "ListMemory.h"
+
+// Doubly linked ring closed through a sentinel node that lives inside the
+// list object. The sentinel is end(): its next is the front and its prev
+// the back, so an empty list is the sentinel pointing at itself and no
+// insert or erase needs a head/tail special case.
+//
+// Because the ring is closed, rotation moves the sentinel rather than any
+// element: rotate() is O(1) and rotate_left/right(k) cost only the walk to
+// the new front. cyclic_next()/cyclic_prev() step a cursor round the ring,
+// skipping the sentinel, which is what round-robin schedulers want.
+// splice() moves nodes between lists without allocating, and iterators
+// stay valid across rotation and splicing.
+template <typename T>
+class CircularDoublyLinkedList {
+private:
+    struct Link {
+        Link* prev;
+        Link* next;
+    };
+
+    struct Node : Link {
+        T data;
+
+        template <typename... Args>
+        explicit Node(Args&&... args) : Link{nullptr, nullptr}, data(std::forward<Args>(args)...) {}
+    };
+
+    Link sentinel;
+    size_t sz;
+
+    static Node* asNode(Link* link) { return static_cast<Node*>(link); }
+    static const Node* asNode(const Link* link) { return static_cast<const Node*>(link); }
+
+    // Links the detached segment first..last in front of pos.
+    static void linkBefore(Link* pos, Link* first, Link* last) {
+        Link* before = pos->prev;
+        first->prev = before;
+        last->next = pos;
+        before->next = first;
+        pos->prev = last;
+    }
+
+    static void unlink(Link* first, Link* last) {
+        first->prev->next = last->next;
+        last->next->prev = first->prev;
+    }
+
+    void reset() {
+        sentinel.prev = sentinel.next = &sentinel;
+        sz = 0;
+    }
+
+    // Takes over other's ring. The sentinel is part of the object, so the
+    // ring's two ends are repointed at ours.
+    void adopt(CircularDoublyLinkedList& other) {
+        if (other.sz == 0) {
+            reset();
+            return;
+        }
+        sentinel = other.sentinel;
+        sentinel.next->prev = &sentinel;
+        sentinel.prev->next = &sentinel;
+        sz = other.sz;
+        other.reset();
+    }
+
+    template <typename... Args>
+    Link* insertBefore(Link* pos, Args&&... args) {
+        Node* node = new Node(std::forward<Args>(args)...);
+        linkBefore(pos, node, node);
+        ++sz;
+        return node;
+    }
+
+    Link* eraseNode(Link* link) {
+        Link* next = link->next;
+        unlink(link, link);
+        delete asNode(link);
+        --sz;
+        return next;
+    }
+
+    // Element at index (< sz), walking from the nearer end; index == sz
+    // yields the sentinel.
+    Link* linkAt(size_t index) const {
+        Link* cur = const_cast<Link*>(&sentinel);
+        if (index <= sz / 2) {
+            for (size_t i = 0; i <= index; ++i) cur = cur->next;
+        } else {
+            for (size_t i = sz; i > index; --i) cur = cur->prev;
+        }
+        return cur;
+    }
+
+    // Re-seats the sentinel in front of node, making node the front. O(1).
+    void makeFront(Link* node) {
+        if (node == sentinel.next) return;
+        unlink(&sentinel, &sentinel);
+        linkBefore(node, &sentinel, &sentinel);
+    }
+
+public:
+    template <bool IsConst>
+    class IteratorImpl {
+        using LinkPtr = typename std::conditional<IsConst, const Link*, Link*>::type;
+        using Ref = typename std::conditional<IsConst, const T&, T&>::type;
+        using Ptr = typename std::conditional<IsConst, const T*, T*>::type;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Ptr;
+        using reference = Ref;
+
+        IteratorImpl() : current(nullptr) {}
+        explicit IteratorImpl(LinkPtr link) : current(link) {}
+
+        reference operator*() const { return asNode(current)->data; }
+        pointer operator->() const { return &(asNode(current)->data); }
+
+        IteratorImpl& operator++() {
+            current = current->next;
+            return *this;
+        }
+
+        IteratorImpl operator++(int) {
+            IteratorImpl tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        IteratorImpl& operator--() {
+            current = current->prev;
+            return *this;
+        }
+
+        IteratorImpl operator--(int) {
+            IteratorImpl tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const IteratorImpl& other) const { return current == other.current; }
+        bool operator!=(const IteratorImpl& other) const { return current != other.current; }
+
+        operator IteratorImpl<true>() const { return IteratorImpl<true>(current); }
+
+    private:
+        friend class CircularDoublyLinkedList;
+        LinkPtr current;
+    };
+
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    CircularDoublyLinkedList() { reset(); }
+
+    CircularDoublyLinkedList(std::initializer_list<T> init) : CircularDoublyLinkedList() {
+        for (const auto& val : init) push_back(val);
+    }
+
+    CircularDoublyLinkedList(const CircularDoublyLinkedList& other) : CircularDoublyLinkedList() {
+        for (const auto& val : other) push_back(val);
+    }
+
+    CircularDoublyLinkedList& operator=(const CircularDoublyLinkedList& other) {
+        if (this != &other) {
+            clear();
+            for (const auto& val : other) push_back(val);
+        }
+        return *this;
+    }
+
+    CircularDoublyLinkedList(CircularDoublyLinkedList&& other) noexcept { adopt(other); }
+
+    CircularDoublyLinkedList& operator=(CircularDoublyLinkedList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            adopt(other);
+        }
+        return *this;
+    }
+
+    ~CircularDoublyLinkedList() { clear(); }
+
+    iterator begin() { return iterator(sentinel.next); }
+    iterator end() { return iterator(&sentinel); }
+    const_iterator begin() const { return cbegin(); }
+    const_iterator end() const { return cend(); }
+    const_iterator cbegin() const { return const_iterator(sentinel.next); }
+    const_iterator cend() const { return const_iterator(&sentinel); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+    const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+
+    bool empty() const { return sz == 0; }
+    size_t size() const { return sz; }
+
+    // Footprint of the list (see ListMemory.h). O(1).
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m;
+        list_memory::add_nodes(m, sz, sizeof(Node), sizeof(T));
+        m.overhead_bytes += sizeof(*this);
+        return m;
+    }
+
+    T& front() {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return asNode(sentinel.next)->data;
+    }
+
+    const T& front() const {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return asNode(sentinel.next)->data;
+    }
+
+    T& back() {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        return asNode(sentinel.prev)->data;
+    }
+
+    const T& back() const {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        return asNode(sentinel.prev)->data;
+    }
+
+    T& at(size_t index) {
+        if (index >= sz) throw std::out_of_range("at: index out of range");
+        return asNode(linkAt(index))->data;
+    }
+
+    const T& at(size_t index) const {
+        if (index >= sz) throw std::out_of_range("at: index out of range");
+        return asNode(linkAt(index))->data;
+    }
+
+    // Modifiers
+
+    void push_front(const T& value) { insertBefore(sentinel.next, value); }
+    void push_front(T&& value) { insertBefore(sentinel.next, std::move(value)); }
+    void push_back(const T& value) { insertBefore(&sentinel, value); }
+    void push_back(T&& value) { insertBefore(&sentinel, std::move(value)); }
+
+    template <typename... Args>
+    void emplace_front(Args&&... args) {
+        insertBefore(sentinel.next, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        insertBefore(&sentinel, std::forward<Args>(args)...);
+    }
+
+    iterator insert(const_iterator pos, const T& value) {
+        return iterator(insertBefore(const_cast<Link*>(pos.current), value));
+    }
+
+    iterator insert(const_iterator pos, T&& value) {
+        return iterator(insertBefore(const_cast<Link*>(pos.current), std::move(value)));
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        return iterator(insertBefore(const_cast<Link*>(pos.current), std::forward<Args>(args)...));
+    }
+
+    // index == size() appends.
+    bool insert_at(size_t index, const T& value) {
+        if (index > sz) return false;
+        insertBefore(linkAt(index), value);
+        return true;
+    }
+
+    bool insert_at(size_t index, T&& value) {
+        if (index > sz) return false;
+        insertBefore(linkAt(index), std::move(value));
+        return true;
+    }
+
+    bool pop_front() {
+        if (empty()) return false;
+        eraseNode(sentinel.next);
+        return true;
+    }
+
+    bool pop_back() {
+        if (empty()) return false;
+        eraseNode(sentinel.prev);
+        return true;
+    }
+
+    bool erase_at(size_t index) {
+        if (index >= sz) return false;
+        eraseNode(linkAt(index));
+        return true;
+    }
+
+    // Erasing end() is a no-op that returns end().
+    iterator erase(const_iterator pos) {
+        Link* link = const_cast<Link*>(pos.current);
+        if (link == &sentinel) return end();
+        return iterator(eraseNode(link));
+    }
+
+    // Erases [first, last) and returns last.
+    iterator erase(const_iterator first, const_iterator last) {
+        Link* cur = const_cast<Link*>(first.current);
+        Link* stop = const_cast<Link*>(last.current);
+        while (cur != stop) cur = eraseNode(cur);
+        return iterator(stop);
+    }
+
+    void clear() {
+        Link* cur = sentinel.next;
+        while (cur != &sentinel) {
+            Link* nxt = cur->next;
+            delete asNode(cur);
+            cur = nxt;
+        }
+        reset();
+    }
+
+    // Moves the front element to the back. O(1): only the sentinel moves.
+    void rotate() {
+        if (sz <= 1) return;
+        // back S front second  ->  back front S second
+        Link* front = sentinel.next;
+        Link* back = sentinel.prev;
+        Link* second = front->next;
+        back->next = front;
+        front->prev = back;
+        front->next = &sentinel;
+        sentinel.prev = front;
+        sentinel.next = second;
+        second->prev = &sentinel;
+    }
+
+    // The element at index k (mod size()) becomes the front. O(min(k, n - k)).
+    void rotate_left(size_t k) {
+        if (sz <= 1) return;
+        k %= sz;
+        if (k != 0) makeFront(linkAt(k));
+    }
+
+    // The element k places from the back (mod size()) becomes the front.
+    void rotate_right(size_t k) {
+        if (sz <= 1) return;
+        k %= sz;
+        if (k != 0) makeFront(linkAt(sz - k));
+    }
+
+    // Makes the element at it the front. O(1).
+    void rotate_to(const_iterator it) {
+        if (it.current != &sentinel) makeFront(const_cast<Link*>(it.current));
+    }
+
+    // Next and previous element round the ring, skipping the sentinel:
+    // cyclic_next of the back is the front. end() for an empty list. O(1).
+    iterator cyclic_next(const_iterator it) {
+        Link* next = it.current->next;
+        return iterator(next == &sentinel ? next->next : next);
+    }
+
+    iterator cyclic_prev(const_iterator it) {
+        Link* prev = it.current->prev;
+        return iterator(prev == &sentinel ? prev->prev : prev);
+    }
+
+    const_iterator cyclic_next(const_iterator it) const {
+        return const_cast<CircularDoublyLinkedList*>(this)->cyclic_next(it);
+    }
+
+    const_iterator cyclic_prev(const_iterator it) const {
+        return const_cast<CircularDoublyLinkedList*>(this)->cyclic_prev(it);
+    }
+
+    // Moves all of other's nodes in front of pos. O(1).
+    void splice(const_iterator pos, CircularDoublyLinkedList& other) {
+        if (this == &other || other.empty()) return;
+        Link* first = other.sentinel.next;
+        Link* last = other.sentinel.prev;
+        size_t n = other.sz;
+        other.reset();
+        linkBefore(const_cast<Link*>(pos.current), first, last);
+        sz += n;
+    }
+
+    // Moves the node at it from other in front of pos. O(1).
+    void splice(const_iterator pos, CircularDoublyLinkedList& other, const_iterator it) {
+        Link* node = const_cast<Link*>(it.current);
+        Link* at = const_cast<Link*>(pos.current);
+        if (node == at || node->next == at) return;
+        unlink(node, node);
+        --other.sz;
+        linkBefore(at, node, node);
+        ++sz;
+    }
+
+    // Moves [first, last) from other in front of pos, which must not lie
+    // inside the range. O(range length) to count it, O(1) within one list.
+    void splice(const_iterator pos, CircularDoublyLinkedList& other, const_iterator first,
+                const_iterator last) {
+        if (first == last) return;
+        Link* chainFirst = const_cast<Link*>(first.current);
+        Link* chainLast = last.current->prev;
+        if (this != &other) {
+            size_t n = 0;
+            for (const Link* cur = chainFirst; cur != last.current; cur = cur->next) ++n;
+            other.sz -= n;
+            sz += n;
+        }
+        unlink(chainFirst, chainLast);
+        linkBefore(const_cast<Link*>(pos.current), chainFirst, chainLast);
+    }
+
+    bool contains(const T& value) const {
+        for (const auto& v : *this) {
+            if (v == value) return true;
+        }
+        return false;
+    }
+};
+
+template <typename T>
+bool operator==(const CircularDoublyLinkedList<T>& lhs, const CircularDoublyLinkedList<T>& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    auto a = lhs.begin();
+    for (auto b = rhs.begin(); b != rhs.end(); ++a, ++b) {
+        if (!(*a == *b)) return false;
+    }
+    return true;
+}
+
+template <typename T>
+bool operator!=(const CircularDoublyLinkedList<T>& lhs, const CircularDoublyLinkedList<T>& rhs) {
+    return !(lhs == rhs);
+}
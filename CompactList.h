@@ -0,0 +1,502 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ListMemory.h"
+#include "SlotListBase.h"
+
+// Memory-lean lists for integral payloads.
+//
+// CompactList<T> is a doubly linked list whose nodes live in one arena and
+// refer to each other by 32-bit offset from the arena base instead of by
+// pointer (the slot list core in SlotListBase.h, shared with
+// IndexedLinkedList). An int node is 12 bytes ({value, prev, next}) where a
+// DoublyLinkedList<int> node is 24 bytes plus a heap header, and there is
+// one allocation for the whole list instead of one per node. Unlike
+// IndexedLinkedList, which splits values and links into separate arrays
+// for whole-array scans, a node's fields sit together so that following
+// links touches one cache line per hop.
+//
+// PackedSortedList<T> goes further for sorted data: values are stored in
+// runs of LEB128 varint deltas, so dense sorted keys (ids, timestamps,
+// offsets) cost one or two bytes each.
+
+template <typename T>
+class CompactList : public SlotListBase<CompactList<T>, T, uint32_t> {
+    static_assert(std::is_integral<T>::value, "CompactList requires an integral element type");
+
+    using Base = SlotListBase<CompactList<T>, T, uint32_t>;
+    friend Base;
+
+public:
+    using offset_type = uint32_t;
+    using Base::npos;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+
+private:
+    struct Node {
+        T value;
+        offset_type prev;
+        offset_type next;
+    };
+
+    using Base::head;
+    using Base::tail;
+    using Base::freeHead;
+    using Base::sz;
+
+    std::vector<Node> arena;
+
+    T& valueOf(offset_type off) { return arena[off].value; }
+    const T& valueOf(offset_type off) const { return arena[off].value; }
+    offset_type& nextOf(offset_type off) { return arena[off].next; }
+    offset_type nextOf(offset_type off) const { return arena[off].next; }
+    offset_type& prevOf(offset_type off) { return arena[off].prev; }
+    offset_type prevOf(offset_type off) const { return arena[off].prev; }
+
+    offset_type appendSlot(T value) {
+        if (arena.size() >= npos) throw std::length_error("CompactList: too many elements");
+        offset_type off = static_cast<offset_type>(arena.size());
+        arena.emplace_back();
+        arena[off].value = value;
+        return off;
+    }
+
+public:
+    CompactList() = default;
+
+    CompactList(std::initializer_list<T> init) : CompactList() {
+        reserve(init.size());
+        for (T val : init) this->push_back(val);
+    }
+
+    template <typename InputIt>
+    CompactList(InputIt first, InputIt last) : CompactList() {
+        for (; first != last; ++first) this->push_back(*first);
+    }
+
+    size_t capacity() const { return arena.capacity(); }
+
+    void reserve(size_t n) { arena.reserve(n); }
+
+    // Footprint of the list (see ListMemory.h). Free-listed nodes and spare
+    // arena capacity count as slack. O(1).
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m;
+        m.live_bytes = sz * sizeof(T);
+        m.overhead_bytes = sizeof(*this) + sz * (sizeof(Node) - sizeof(T));
+        m.slack_bytes = (arena.size() - sz) * sizeof(Node);
+        list_memory::add_vector_buffer(m, arena.size(), arena.capacity(), sizeof(Node));
+        return m;
+    }
+
+    void clear() {
+        arena.clear();
+        this->resetLinks();
+    }
+
+    void reverse() {
+        for (offset_type cur = head; cur != npos;) {
+            Node& node = arena[cur];
+            std::swap(node.prev, node.next);
+            cur = node.prev;
+        }
+        std::swap(head, tail);
+    }
+
+    // Rebuilds the arena in list order without free nodes and releases spare
+    // capacity, so a walk is a sequential scan and slack drops to zero.
+    void shrink_to_fit() {
+        std::vector<Node> packed;
+        packed.reserve(sz);
+        for (offset_type cur = head; cur != npos; cur = arena[cur].next) {
+            offset_type i = static_cast<offset_type>(packed.size());
+            packed.push_back(Node{arena[cur].value, i == 0 ? npos : i - 1, i + 1 < sz ? i + 1 : npos});
+        }
+        arena.swap(packed);
+        head = sz ? 0 : npos;
+        tail = sz ? static_cast<offset_type>(sz - 1) : npos;
+        freeHead = npos;
+    }
+
+    bool contains(T value) const {
+        for (offset_type cur = head; cur != npos; cur = arena[cur].next) {
+            if (arena[cur].value == value) return true;
+        }
+        return false;
+    }
+};
+
+template <typename T>
+bool operator==(const CompactList<T>& lhs, const CompactList<T>& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T>
+bool operator!=(const CompactList<T>& lhs, const CompactList<T>& rhs) {
+    return !(lhs == rhs);
+}
+
+// Sorted multiset of integral values stored as a linked chain of packed
+// runs. A run keeps its first value verbatim and each later value as the
+// varint-encoded difference from its predecessor, in a fixed kRunBytes
+// buffer; runs link to each other by 32-bit arena offset like CompactList
+// nodes.
+//
+// Appending in order (push_back, or building from a sorted range) packs in
+// place. insert() and erase() elsewhere unpack one run, edit it and repack
+// it, splitting a run that overflows; finding the run walks the run heads,
+// O(n / values per run). Iteration is forward only and decodes on the fly.
+template <typename T>
+class PackedSortedList {
+    static_assert(std::is_integral<T>::value, "PackedSortedList requires an integral element type");
+
+public:
+    using offset_type = uint32_t;
+    static constexpr offset_type npos = static_cast<offset_type>(-1);
+    static constexpr size_t kRunBytes = 48;
+
+private:
+    using U = typename std::make_unsigned<T>::type;
+
+    // Every delta takes at least one byte.
+    static constexpr size_t kMaxRunValues = kRunBytes + 1;
+    static constexpr size_t kMaxVarintBytes = (sizeof(U) * 8 + 6) / 7;
+
+    struct Run {
+        T first;
+        offset_type prev;
+        offset_type next;
+        uint16_t count;   // values in the run, first included
+        uint16_t used;    // bytes of bytes[] holding deltas
+        uint8_t bytes[kRunBytes];
+    };
+
+    std::vector<Run> arena;
+    offset_type head;
+    offset_type tail;
+    offset_type freeHead;   // free runs, threaded through next
+    size_t sz;
+    size_t runs;
+    T lastValue;   // back(), kept so appends need not decode the tail run
+
+    static size_t varintSize(U v) {
+        size_t n = 1;
+        while (v >= 0x80) {
+            v >>= 7;
+            ++n;
+        }
+        return n;
+    }
+
+    static size_t putVarint(uint8_t* out, U v) {
+        size_t n = 0;
+        while (v >= 0x80) {
+            out[n++] = static_cast<uint8_t>(v | 0x80);
+            v >>= 7;
+        }
+        out[n++] = static_cast<uint8_t>(v);
+        return n;
+    }
+
+    static U getVarint(const uint8_t* in, size_t& pos) {
+        U v = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            uint8_t b = in[pos++];
+            v |= static_cast<U>(b & 0x7f) << shift;
+            if (!(b & 0x80)) return v;
+        }
+    }
+
+    // Differences are taken in the unsigned type: for b >= a the result is
+    // the true distance even when it does not fit in T.
+    static U delta(T a, T b) { return static_cast<U>(static_cast<U>(b) - static_cast<U>(a)); }
+
+    offset_type allocRun(T first) {
+        offset_type off;
+        if (freeHead != npos) {
+            off = freeHead;
+            freeHead = arena[off].next;
+        } else {
+            if (arena.size() >= npos) throw std::length_error("PackedSortedList: too many runs");
+            off = static_cast<offset_type>(arena.size());
+            arena.emplace_back();
+        }
+        Run& r = arena[off];
+        r.first = first;
+        r.prev = r.next = npos;
+        r.count = 1;
+        r.used = 0;
+        ++runs;
+        return off;
+    }
+
+    void linkAfter(offset_type pos, offset_type off) {
+        offset_type after = (pos == npos) ? head : arena[pos].next;
+        arena[off].prev = pos;
+        arena[off].next = after;
+        if (pos != npos) arena[pos].next = off;
+        else head = off;
+        if (after != npos) arena[after].prev = off;
+        else tail = off;
+    }
+
+    void freeRun(offset_type off) {
+        offset_type p = arena[off].prev;
+        offset_type n = arena[off].next;
+        if (p != npos) arena[p].next = n;
+        else head = n;
+        if (n != npos) arena[n].prev = p;
+        else tail = p;
+        arena[off].prev = npos;
+        arena[off].next = freeHead;
+        freeHead = off;
+        --runs;
+    }
+
+    size_t unpack(offset_type off, T* out) const {
+        const Run& r = arena[off];
+        T v = r.first;
+        out[0] = v;
+        size_t pos = 0;
+        for (size_t i = 1; i < r.count; ++i) {
+            v = static_cast<T>(static_cast<U>(v) + getVarint(r.bytes, pos));
+            out[i] = v;
+        }
+        return r.count;
+    }
+
+    // Packs vals[0, n) into run off and, if they do not fit, into new runs
+    // linked after it. When splitting, the first run is only filled to about
+    // half of the total so both halves have room to grow.
+    void repack(offset_type off, const T* vals, size_t n) {
+        size_t total = 0;
+        for (size_t i = 1; i < n; ++i) total += varintSize(delta(vals[i - 1], vals[i]));
+        size_t limit = total <= kRunBytes ? kRunBytes : total / 2;
+        size_t i = 0;
+        for (;;) {
+            Run& r = arena[off];
+            r.first = vals[i];
+            r.count = 1;
+            r.used = 0;
+            for (++i; i < n; ++i) {
+                U d = delta(vals[i - 1], vals[i]);
+                if (r.used + varintSize(d) > limit) break;
+                r.used = static_cast<uint16_t>(r.used + putVarint(r.bytes + r.used, d));
+                ++r.count;
+            }
+            if (i == n) return;
+            limit = kRunBytes;
+            offset_type fresh = allocRun(vals[i]);
+            linkAfter(off, fresh);
+            off = fresh;
+        }
+    }
+
+    // The last run whose first value is <= value, or head if none is.
+    offset_type findRun(T value) const {
+        if (tail != npos && !(value < arena[tail].first)) return tail;
+        offset_type cur = head;
+        while (arena[cur].next != npos && !(value < arena[arena[cur].next].first)) cur = arena[cur].next;
+        return cur;
+    }
+
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        reference operator*() const { return value; }
+        pointer operator->() const { return &value; }
+
+        const_iterator& operator++() {
+            const Run& r = list->arena[run];
+            if (++index < r.count) {
+                value = static_cast<T>(static_cast<U>(value) + getVarint(r.bytes, pos));
+            } else {
+                enter(r.next);
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return run == other.run && index == other.index;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class PackedSortedList;
+
+        const_iterator(const PackedSortedList* l, offset_type r) : list(l) { enter(r); }
+
+        void enter(offset_type r) {
+            run = r;
+            index = 0;
+            pos = 0;
+            if (r != npos) value = list->arena[r].first;
+        }
+
+        const PackedSortedList* list;
+        offset_type run;
+        size_t index = 0;
+        size_t pos = 0;
+        T value = T();
+    };
+
+    using iterator = const_iterator;
+
+    PackedSortedList() : head(npos), tail(npos), freeHead(npos), sz(0), runs(0), lastValue() {}
+
+    PackedSortedList(std::initializer_list<T> init) : PackedSortedList() {
+        for (T val : init) insert(val);
+    }
+
+    // Any order is accepted; a sorted range is appended in place.
+    template <typename InputIt>
+    PackedSortedList(InputIt first, InputIt last) : PackedSortedList() {
+        for (; first != last; ++first) insert(*first);
+    }
+
+    const_iterator begin() const { return const_iterator(this, head); }
+    const_iterator end() const { return const_iterator(this, npos); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    bool empty() const { return sz == 0; }
+    size_t size() const { return sz; }
+    size_t run_count() const { return runs; }
+
+    // Footprint of the list (see ListMemory.h). Live bytes are what the
+    // packed values actually occupy (each run's first value plus its delta
+    // bytes); the unused part of each run buffer is slack. O(runs).
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m;
+        for (offset_type cur = head; cur != npos; cur = arena[cur].next) {
+            m.live_bytes += sizeof(T) + arena[cur].used;
+            m.slack_bytes += kRunBytes - arena[cur].used;
+        }
+        m.overhead_bytes = sizeof(*this) + runs * (sizeof(Run) - sizeof(T) - kRunBytes);
+        m.slack_bytes += (arena.size() - runs) * sizeof(Run);
+        list_memory::add_vector_buffer(m, arena.size(), arena.capacity(), sizeof(Run));
+        return m;
+    }
+
+    T front() const {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return arena[head].first;
+    }
+
+    T back() const {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        return lastValue;
+    }
+
+    // Appends value, which must not be smaller than back(). O(1).
+    void push_back(T value) {
+        if (empty()) {
+            linkAfter(npos, allocRun(value));
+        } else {
+            if (value < lastValue) throw std::invalid_argument("PackedSortedList::push_back: value out of order");
+            Run& r = arena[tail];
+            U d = delta(lastValue, value);
+            if (r.used + varintSize(d) <= kRunBytes) {
+                r.used = static_cast<uint16_t>(r.used + putVarint(r.bytes + r.used, d));
+                ++r.count;
+            } else {
+                linkAfter(tail, allocRun(value));
+            }
+        }
+        lastValue = value;
+        ++sz;
+    }
+
+    // Inserts value after any equal values already present.
+    void insert(T value) {
+        if (empty() || !(value < back())) {
+            push_back(value);
+            return;
+        }
+        offset_type off = findRun(value);
+        T vals[kMaxRunValues + 1];
+        size_t n = unpack(off, vals);
+        T* at = std::upper_bound(vals, vals + n, value);
+        std::move_backward(at, vals + n, vals + n + 1);
+        *at = value;
+        repack(off, vals, n + 1);
+        ++sz;
+    }
+
+    // Removes one occurrence of value; returns false if there is none.
+    bool erase(T value) {
+        if (empty() || value < arena[head].first) return false;
+        offset_type off = findRun(value);
+        T vals[kMaxRunValues];
+        size_t n = unpack(off, vals);
+        T* at = std::lower_bound(vals, vals + n, value);
+        if (at == vals + n || *at != value) return false;
+        std::move(at + 1, vals + n, at);
+        if (--n == 0) freeRun(off);
+        else repack(off, vals, n);
+        --sz;
+        if (tail != npos) {
+            T tailVals[kMaxRunValues];
+            lastValue = tailVals[unpack(tail, tailVals) - 1];
+        }
+        return true;
+    }
+
+    bool contains(T value) const {
+        if (empty() || value < arena[head].first) return false;
+        T vals[kMaxRunValues];
+        size_t n = unpack(findRun(value), vals);
+        return std::binary_search(vals, vals + n, value);
+    }
+
+    void clear() {
+        arena.clear();
+        head = tail = freeHead = npos;
+        sz = 0;
+        runs = 0;
+    }
+
+    std::vector<T> to_vector() const {
+        std::vector<T> v;
+        v.reserve(sz);
+        for (T val : *this) v.push_back(val);
+        return v;
+    }
+};
+
+template <typename T>
+bool operator==(const PackedSortedList<T>& lhs, const PackedSortedList<T>& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T>
+bool operator!=(const PackedSortedList<T>& lhs, const PackedSortedList<T>& rhs) {
+    return !(lhs == rhs);
+}
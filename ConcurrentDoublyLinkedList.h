@@ -0,0 +1,290 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <utility>
+
+#include "DoublyLinkedList.h"
+#include "EpochReclamation.h"
+#include "ListMemory.h"
+
+// Doubly linked list for read-mostly sharing between threads, RCU style.
+//
+// Readers take no locks: they open a ReadView (an epoch guard) and walk the
+// forward links, which writers only ever swing atomically. Writers are
+// serialized by a mutex, unlink nodes without touching their forward link,
+// and retire them to EpochDomain instead of deleting them, so a reader that
+// is standing on a node when it is erased can still step past it safely.
+//
+// Elements are immutable once published; update by erase + insert.
+template <typename T>
+class ConcurrentDoublyLinkedList {
+private:
+    struct Node {
+        T data;
+        std::atomic<Node*> next;
+        Node* prev;          // writer-side only
+        bool unlinked;       // writer-side only
+
+        explicit Node(const T& value) : data(value), next(nullptr), prev(nullptr), unlinked(false) {}
+        explicit Node(T&& value) : data(std::move(value)), next(nullptr), prev(nullptr), unlinked(false) {}
+    };
+
+    std::atomic<Node*> head;
+    Node* tail;
+    std::atomic<size_t> sz;
+    std::mutex writeMutex;
+
+    static void deleteNode(void* p) {
+        delete static_cast<Node*>(p);
+    }
+
+    static void deleteChain(void* p) {
+        Node* cur = static_cast<Node*>(p);
+        while (cur) {
+            Node* nxt = cur->next.load(std::memory_order_relaxed);
+            delete cur;
+            cur = nxt;
+        }
+    }
+
+    // Writer-side helpers; writeMutex must be held.
+    void linkBack(Node* node) {
+        node->prev = tail;
+        if (tail) tail->next.store(node, std::memory_order_release);
+        else head.store(node, std::memory_order_release);
+        tail = node;
+        sz.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void linkFront(Node* node) {
+        Node* first = head.load(std::memory_order_relaxed);
+        node->next.store(first, std::memory_order_relaxed);
+        if (first) first->prev = node;
+        else tail = node;
+        head.store(node, std::memory_order_release);
+        sz.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // The unlinked node keeps its forward link so in-flight readers can move on.
+    void unlinkAndRetire(Node* node) {
+        Node* nxt = node->next.load(std::memory_order_relaxed);
+        if (node->prev) node->prev->next.store(nxt, std::memory_order_release);
+        else head.store(nxt, std::memory_order_release);
+        if (nxt) nxt->prev = node->prev;
+        else tail = node->prev;
+        node->unlinked = true;
+        sz.fetch_sub(1, std::memory_order_relaxed);
+        EpochDomain::global().retire(node, &deleteNode);
+    }
+
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() : current(nullptr) {}
+        explicit const_iterator(const Node* node) : current(node) {}
+
+        reference operator*() const { return current->data; }
+        pointer operator->() const { return &(current->data); }
+
+        const_iterator& operator++() {
+            current = current->next.load(std::memory_order_acquire);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const { return current == other.current; }
+        bool operator!=(const const_iterator& other) const { return current != other.current; }
+
+    private:
+        friend class ConcurrentDoublyLinkedList;
+        const Node* current;
+    };
+
+    // A lock-free read session. Iterators obtained from it stay valid (though
+    // possibly pointing at already-erased elements) until the view is destroyed.
+    class ReadView {
+    public:
+        explicit ReadView(const ConcurrentDoublyLinkedList& l) : guard(), list(&l) {}
+
+        const_iterator begin() const {
+            return const_iterator(list->head.load(std::memory_order_acquire));
+        }
+        const_iterator end() const { return const_iterator(nullptr); }
+
+    private:
+        EpochGuard guard;
+        const ConcurrentDoublyLinkedList* list;
+    };
+
+    ConcurrentDoublyLinkedList() : head(nullptr), tail(nullptr), sz(0) {}
+
+    ConcurrentDoublyLinkedList(std::initializer_list<T> init) : ConcurrentDoublyLinkedList() {
+        for (const auto& val : init) push_back(val);
+    }
+
+    explicit ConcurrentDoublyLinkedList(const DoublyLinkedList<T>& other) : ConcurrentDoublyLinkedList() {
+        for (const auto& val : other) push_back(val);
+    }
+
+    ConcurrentDoublyLinkedList(const ConcurrentDoublyLinkedList&) = delete;
+    ConcurrentDoublyLinkedList& operator=(const ConcurrentDoublyLinkedList&) = delete;
+
+    // No reader or writer may be active when the list itself is destroyed.
+    ~ConcurrentDoublyLinkedList() {
+        deleteChain(head.load(std::memory_order_relaxed));
+    }
+
+    ReadView read() const { return ReadView(*this); }
+
+    // Approximate while writers are active.
+    size_t size() const { return sz.load(std::memory_order_relaxed); }
+    bool empty() const { return head.load(std::memory_order_acquire) == nullptr; }
+
+    // Footprint of the linked nodes (see ListMemory.h). Unlinked nodes still
+    // waiting for their epoch to pass are not included. Approximate while
+    // writers are active.
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m;
+        list_memory::add_nodes(m, size(), sizeof(Node), sizeof(T));
+        m.overhead_bytes += sizeof(*this);
+        return m;
+    }
+
+    // Readers
+
+    template <typename F>
+    void for_each(F&& f) const {
+        ReadView view(*this);
+        for (const T& val : view) f(val);
+    }
+
+    bool contains(const T& value) const {
+        ReadView view(*this);
+        for (const T& val : view) {
+            if (val == value) return true;
+        }
+        return false;
+    }
+
+    bool try_front(T& out) const {
+        ReadView view(*this);
+        const_iterator it = view.begin();
+        if (it == view.end()) return false;
+        out = *it;
+        return true;
+    }
+
+    DoublyLinkedList<T> snapshot() const {
+        DoublyLinkedList<T> copy;
+        ReadView view(*this);
+        for (const T& val : view) copy.push_back(val);
+        return copy;
+    }
+
+    // Writers
+
+    void push_front(const T& value) {
+        Node* node = new Node(value);
+        std::lock_guard<std::mutex> lock(writeMutex);
+        linkFront(node);
+    }
+
+    void push_front(T&& value) {
+        Node* node = new Node(std::move(value));
+        std::lock_guard<std::mutex> lock(writeMutex);
+        linkFront(node);
+    }
+
+    void push_back(const T& value) {
+        Node* node = new Node(value);
+        std::lock_guard<std::mutex> lock(writeMutex);
+        linkBack(node);
+    }
+
+    void push_back(T&& value) {
+        Node* node = new Node(std::move(value));
+        std::lock_guard<std::mutex> lock(writeMutex);
+        linkBack(node);
+    }
+
+    bool pop_front() {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        Node* first = head.load(std::memory_order_relaxed);
+        if (!first) return false;
+        unlinkAndRetire(first);
+        return true;
+    }
+
+    bool pop_back() {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (!tail) return false;
+        unlinkAndRetire(tail);
+        return true;
+    }
+
+    // Erases the element pos refers to. Returns false if another writer
+    // already erased it.
+    bool erase(const_iterator pos) {
+        if (!pos.current) return false;
+        std::lock_guard<std::mutex> lock(writeMutex);
+        Node* node = const_cast<Node*>(pos.current);
+        if (node->unlinked) return false;
+        unlinkAndRetire(node);
+        return true;
+    }
+
+    bool remove_first(const T& value) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        for (Node* cur = head.load(std::memory_order_relaxed); cur;
+             cur = cur->next.load(std::memory_order_relaxed)) {
+            if (cur->data == value) {
+                unlinkAndRetire(cur);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int remove_all(const T& value) {
+        int removed = 0;
+        std::lock_guard<std::mutex> lock(writeMutex);
+        Node* cur = head.load(std::memory_order_relaxed);
+        while (cur) {
+            Node* nxt = cur->next.load(std::memory_order_relaxed);
+            if (cur->data == value) {
+                unlinkAndRetire(cur);
+                ++removed;
+            }
+            cur = nxt;
+        }
+        return removed;
+    }
+
+    // Detaches the whole chain at once and retires it as a single object.
+    void clear() {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        Node* first = head.load(std::memory_order_relaxed);
+        if (!first) return;
+        head.store(nullptr, std::memory_order_release);
+        tail = nullptr;
+        sz.store(0, std::memory_order_relaxed);
+        for (Node* cur = first; cur; cur = cur->next.load(std::memory_order_relaxed)) {
+            cur->unlinked = true;
+        }
+        EpochDomain::global().retire(first, &deleteChain);
+    }
+};
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "DoublyLinkedList.h"
+#include "ListMemory.h"
+
+// Copy-on-write handle to a DoublyLinkedList. Copies share one body holding
+// the list and an atomic reference count, so copying, passing by value and
+// returning a list cost O(1) however long it is. The first non-const call
+// on a handle whose body is shared (element access, iterators, push/pop,
+// insert/erase, sort, ...) detaches it: the list is cloned with
+// DoublyLinkedList's bulk copy and the handle lets go of the shared body.
+// Const calls never copy.
+//
+// Non-const calls that hand out references or iterators (at(), front(),
+// begin(), edit(), ...) also mark the body unshareable, as copy-on-write
+// strings used to: the next copy of that handle is a deep one, so a write
+// through a reference taken earlier can never show through a copy. clear()
+// makes the body shareable again.
+//
+// Handles sharing a body may be copied, detached and destroyed on different
+// threads, as with shared_ptr: the count is atomic. Const calls leave the
+// list's finger and hash caches alone while the body is shared (const at()
+// walks with iterators, hash() is recomputed, == compares the elements),
+// so distinct handles sharing a body can be read concurrently without a
+// lock. One handle object read from several threads still needs one, as
+// hash() on an unshared body fills the cache.
+template <typename T>
+class CowDoublyLinkedList {
+private:
+    using List = DoublyLinkedList<T>;
+
+    struct Body {
+        List list;
+        std::atomic<size_t> refs;
+        bool shareable;   // false once references into list were handed out
+
+        Body() : refs(1), shareable(true) {}
+        explicit Body(const List& l) : list(l), refs(1), shareable(true) {}
+        explicit Body(List&& l) : list(std::move(l)), refs(1), shareable(true) {}
+    };
+
+    Body* body;   // nullptr for an empty list that was never written
+
+    static const List& emptyList() {
+        static const List empty;
+        return empty;
+    }
+
+    static Body* share(Body* b) {
+        if (!b) return nullptr;
+        if (!b->shareable) return new Body(b->list);
+        b->refs.fetch_add(1, std::memory_order_relaxed);
+        return b;
+    }
+
+    static void release(Body* b) {
+        if (b && b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete b;
+    }
+
+    // Makes the body exclusive to this handle, cloning it if it is shared,
+    // and returns its list for writing.
+    List& mutate() {
+        if (!body) {
+            body = new Body();
+        } else if (body->refs.load(std::memory_order_acquire) != 1) {
+            Body* copy = new Body(body->list);
+            release(body);
+            body = copy;
+        }
+        return body->list;
+    }
+
+    // mutate() for calls whose result points into the list.
+    List& leak() {
+        List& l = mutate();
+        body->shareable = false;
+        return l;
+    }
+
+    // Logical position of it in the current list; taken before a detach
+    // moves the elements to a clone.
+    size_t indexOf(typename List::const_iterator it) const {
+        return static_cast<size_t>(std::distance(list().cbegin(), it));
+    }
+
+public:
+    using iterator = typename List::iterator;
+    using const_iterator = typename List::const_iterator;
+
+    CowDoublyLinkedList() : body(nullptr) {}
+
+    CowDoublyLinkedList(std::initializer_list<T> init) : body(new Body(List(init))) {}
+
+    explicit CowDoublyLinkedList(const List& list) : body(new Body(list)) {}
+    explicit CowDoublyLinkedList(List&& list) : body(new Body(std::move(list))) {}
+
+    CowDoublyLinkedList(const CowDoublyLinkedList& other) : body(share(other.body)) {}
+
+    CowDoublyLinkedList(CowDoublyLinkedList&& other) noexcept : body(other.body) {
+        other.body = nullptr;
+    }
+
+    CowDoublyLinkedList& operator=(const CowDoublyLinkedList& other) {
+        if (this != &other) {
+            Body* old = body;
+            body = share(other.body);
+            release(old);
+        }
+        return *this;
+    }
+
+    CowDoublyLinkedList& operator=(CowDoublyLinkedList&& other) noexcept {
+        if (this != &other) {
+            release(body);
+            body = other.body;
+            other.body = nullptr;
+        }
+        return *this;
+    }
+
+    ~CowDoublyLinkedList() { release(body); }
+
+    // Read-only view of the list; never copies.
+    const List& list() const { return body ? body->list : emptyList(); }
+
+    // The list for arbitrary edits, for members not forwarded here. Detaches
+    // and marks the body unshareable like begin().
+    List& edit() { return leak(); }
+
+    // Handles sharing this body, this one included (0 for an empty handle
+    // that was never written).
+    size_t use_count() const { return body ? body->refs.load(std::memory_order_relaxed) : 0; }
+
+    // True when both handles share one body.
+    bool shares_with(const CowDoublyLinkedList& other) const {
+        return body != nullptr && body == other.body;
+    }
+
+    iterator begin() { return leak().begin(); }
+    iterator end() { return leak().end(); }
+    const_iterator begin() const { return list().cbegin(); }
+    const_iterator end() const { return list().cend(); }
+    const_iterator cbegin() const { return list().cbegin(); }
+    const_iterator cend() const { return list().cend(); }
+
+    bool empty() const { return list().empty(); }
+    size_t size() const { return list().size(); }
+
+    // Footprint of the list (see ListMemory.h) plus the body. A shared body
+    // is counted in full by every handle, so summing over handles
+    // overstates the total.
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m;
+        if (body) {
+            m = body->list.memory_usage();
+            m.overhead_bytes += sizeof(Body) - sizeof(List);
+            list_memory::add_heap_block(m, sizeof(Body));
+        }
+        m.overhead_bytes += sizeof(*this);
+        return m;
+    }
+
+    T& front() { return leak().front(); }
+    const T& front() const { return list().front(); }
+    T& back() { return leak().back(); }
+    const T& back() const { return list().back(); }
+    T& at(size_t index) { return leak().at(index); }
+    const T& at(size_t index) const {
+        const List& l = list();
+        if (index >= l.size()) throw std::out_of_range("at: index out of range");
+        if (index < l.size() / 2) return *std::next(l.cbegin(), static_cast<std::ptrdiff_t>(index));
+        return *std::prev(l.cend(), static_cast<std::ptrdiff_t>(l.size() - index));
+    }
+    T& operator[](size_t index) { return at(index); }
+    const T& operator[](size_t index) const { return at(index); }
+
+    // Modifiers
+
+    void push_front(const T& value) { mutate().push_front(value); }
+    void push_front(T&& value) { mutate().push_front(std::move(value)); }
+    void push_back(const T& value) { mutate().push_back(value); }
+    void push_back(T&& value) { mutate().push_back(std::move(value)); }
+
+    template <typename... Args>
+    void emplace_front(Args&&... args) {
+        mutate().emplace_front(std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        mutate().emplace_back(std::forward<Args>(args)...);
+    }
+
+    bool insert_at(size_t index, const T& value) { return mutate().insert_at(index, value); }
+    bool insert_at(size_t index, T&& value) { return mutate().insert_at(index, std::move(value)); }
+
+    bool pop_front() { return mutate().pop_front(); }
+    bool pop_back() { return mutate().pop_back(); }
+    bool erase_at(size_t index) { return mutate().erase_at(index); }
+
+    // pos may come from a const begin()/end() taken while the body was
+    // shared; it is carried over to the detached copy.
+    iterator erase(const_iterator pos) {
+        if (use_count() <= 1) return leak().erase(pos);
+        size_t index = indexOf(pos);
+        List& l = leak();
+        return l.erase(std::next(l.cbegin(), static_cast<std::ptrdiff_t>(index)));
+    }
+
+    // Erases [first, last) and returns last.
+    iterator erase(const_iterator first, const_iterator last) {
+        if (use_count() <= 1) return leak().erase(first, last);
+        size_t from = indexOf(first);
+        size_t to = indexOf(last);
+        List& l = leak();
+        auto a = std::next(l.cbegin(), static_cast<std::ptrdiff_t>(from));
+        return l.erase(a, std::next(a, static_cast<std::ptrdiff_t>(to - from)));
+    }
+
+    int remove_all(const T& value) { return mutate().remove_all(value); }
+
+    template <typename Pred>
+    size_t erase_if(Pred pred) {
+        return mutate().erase_if(pred);
+    }
+
+    void unique() { mutate().unique(); }
+
+    // Lets go of the body instead of cloning it just to empty it.
+    void clear() {
+        if (!body) return;
+        if (body->refs.load(std::memory_order_acquire) != 1) {
+            release(body);
+            body = nullptr;
+            return;
+        }
+        body->list.clear();
+        body->shareable = true;
+    }
+
+    void reverse() { mutate().reverse(); }
+    void sort_ascending() { mutate().sort_ascending(); }
+    void sort_descending() { mutate().sort_descending(); }
+
+    bool contains(const T& value) const { return list().contains(value); }
+    int find_first_index(const T& value) const { return list().find_first_index(value); }
+    uint64_t hash() const { return use_count() > 1 ? list().compute_hash() : list().hash(); }
+    std::vector<T> to_vector() const { return list().to_vector(); }
+};
+
+template <typename T>
+bool operator==(const CowDoublyLinkedList<T>& lhs, const CowDoublyLinkedList<T>& rhs) {
+    // Not DoublyLinkedList's ==, which may copy a hash into either side.
+    if (lhs.shares_with(rhs)) return true;
+    return lhs.size() == rhs.size() && std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+template <typename T>
+bool operator!=(const CowDoublyLinkedList<T>& lhs, const CowDoublyLinkedList<T>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T>
+bool operator<(const CowDoublyLinkedList<T>& lhs, const CowDoublyLinkedList<T>& rhs) {
+    return lhs.list() < rhs.list();
+}
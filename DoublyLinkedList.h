@@ -0,0 +1,1969 @@
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <memory>
+#include <type_traits>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+
+#include "ListKernels.h"
+#include "ListMemory.h"
+#include "ListStats.h"
+
+// Per-allocator knobs for the node containers. release_is_noop(a) says that
+// handing memory back to a is pointless because it is only reclaimed in bulk
+// (an arena); with a trivially destructible T, clear() and the destructor
+// then drop the whole chain without visiting the nodes. Specialize for other
+// arena allocators.
+template <typename Alloc>
+struct list_allocator_traits {
+    static constexpr bool release_is_noop(const Alloc&) { return false; }
+};
+
+template <typename U>
+struct list_allocator_traits<std::pmr::polymorphic_allocator<U>> {
+    static bool release_is_noop(const std::pmr::polymorphic_allocator<U>& a) {
+        return dynamic_cast<std::pmr::monotonic_buffer_resource*>(a.resource()) != nullptr;
+    }
+};
+
+template <typename T, typename Allocator = std::allocator<T>>
+class DoublyLinkedList {
+private:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    struct Node {
+        T data;
+        Node* prev;
+        Node* next;
+        
+        LIST_CONSTEXPR Node(const T& value) : data(value), prev(nullptr), next(nullptr) {}
+        LIST_CONSTEXPR Node(T&& value) : data(std::move(value)), prev(nullptr), next(nullptr) {}
+    };
+
+    // Entry of the handle table (see Handle). A live slot points at its
+    // node; a free one is threaded through nextFree. generation is bumped
+    // whenever the slot is freed, so handles to the old node stop matching.
+    struct HandleSlot {
+        Node* node;
+        uint32_t generation;
+        uint32_t nextFree;
+    };
+
+    // Handle table, allocated by the first insert() or handle_of(). Nodes
+    // do not record their slot; slotOf maps the nodes that have one, so a
+    // list that never hands out a handle keeps plain nodes and pays one
+    // null pointer.
+    struct HandleTable {
+        std::vector<HandleSlot> slots;
+        std::unordered_map<const Node*, uint32_t> slotOf;
+        uint32_t freeSlot = kNoSlot;
+    };
+
+public:
+    // Stable O(1) name for one element, from insert() or handle_of(). Unlike
+    // an iterator it is safe to keep after the element goes away: get()
+    // then returns nullptr and erase() false, even once the slot has been
+    // reused. Handles survive inserts, erases of other elements, reverse(),
+    // rotation and splices within the list; the element loses its handle
+    // when it is erased, moved to another list (splice, take_front, merge),
+    // or when sort_ascending/descending() rebuild the list. A handle names
+    // a node, so swap_nodes() leaves it on the node, with the other value.
+    struct Handle {
+        uint32_t slot = kNoSlot;
+        uint32_t generation = 0;
+
+        bool operator==(const Handle& other) const { return slot == other.slot && generation == other.generation; }
+        bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+private:
+
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    
+    // Physical ends. When flipped, the list's logical order is the physical
+    // order backwards (tail first, following prev), which is what makes
+    // reverse() O(1). Code that needs the physical order to be the logical
+    // one calls normalize().
+    Node* head;
+    Node* tail;
+    size_t sz;
+    bool flipped;
+    // Finger: the node last reached by getNodeAt() and its index, so that
+    // sequential or nearby indexed access walks from there instead of from
+    // an end. fingerNode == nullptr means no finger. Every operation that
+    // shifts indices or unlinks nodes adjusts or drops it. Because const
+    // at() moves the finger, concurrent readers of one list need a lock.
+    // fingerIndex is a physical position, so flipping does not move it.
+    mutable Node* fingerNode;
+    mutable size_t fingerIndex;
+    // Content hash (see hash()). While hashValid, hashState describes the
+    // current elements. With tracking on, structural edits keep it up to
+    // date; otherwise it is a cache that any change drops. Non-const
+    // accessors that hand out element references always drop it.
+    mutable list_kernels::SeqHash hashState;
+    mutable bool hashValid;
+    bool hashTracking;
+    // Set once a non-const accessor has handed out something that can write
+    // an element behind the list's back (reference, iterator, get()). Only
+    // clear() resets it, as nothing else can tell when those are gone; it
+    // follows the nodes when they move to another list. operator== trusts
+    // the hash only while it is false on both sides.
+    bool elementsExposed;
+    // The finger and the hash are runtime-only caches. During constant
+    // evaluation (C++20, see LIST_CONSTEXPR) the list never reads them:
+    // GCC 12 rejects reading mutable members there, and lists built at
+    // compile time are small. Indexed access then walks from the nearer
+    // end, and hashValid stays false once the list changes.
+#ifdef LINKED_LIST_ENABLE_STATS
+    mutable ListStats statsData;
+#endif
+    NodeAllocator nodeAlloc;
+    HandleTable* handles;   // nullptr until the first handle
+
+    template <typename... Args>
+    LIST_CONSTEXPR Node* createNode(Args&&... args) {
+        Node* node = NodeTraits::allocate(nodeAlloc, 1);
+        try {
+            NodeTraits::construct(nodeAlloc, node, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(nodeAlloc, node, 1);
+            throw;
+        }
+        LIST_STAT(++statsData.node_allocations;
+                  if (sz + 1 > statsData.peak_size) statsData.peak_size = sz + 1);
+        return node;
+    }
+
+    LIST_CONSTEXPR void destroyNode(Node* node) {
+        LIST_STAT(++statsData.node_frees);
+        releaseSlot(node);
+        NodeTraits::destroy(nodeAlloc, node);
+        NodeTraits::deallocate(nodeAlloc, node, 1);
+    }
+
+    // True when the nodes can simply be abandoned: nothing to destroy and an
+    // allocator that would ignore the deallocation anyway.
+    LIST_CONSTEXPR bool releaseIsNoop() const {
+        return std::is_trivially_destructible<T>::value &&
+               list_allocator_traits<NodeAllocator>::release_is_noop(nodeAlloc);
+    }
+
+    // Frees a detached chain of n nodes linked through next in one tight
+    // loop, or leaves it to the arena when releaseIsNoop().
+    LIST_CONSTEXPR void releaseChain(Node* first, [[maybe_unused]] size_t n) {
+        if (releaseIsNoop() && !hasHandles()) {
+            LIST_STAT(statsData.node_frees += n);
+            return;
+        }
+        while (first) {
+            Node* nxt = first->next;
+            destroyNode(first);
+            first = nxt;
+        }
+    }
+
+    LIST_CONSTEXPR bool hasHandles() const { return handles && !handles->slotOf.empty(); }
+
+    uint32_t acquireSlot(Node* node) {
+        if (!handles) handles = new HandleTable();
+        auto found = handles->slotOf.find(node);
+        if (found != handles->slotOf.end()) return found->second;
+        std::vector<HandleSlot>& slots = handles->slots;
+        uint32_t slot;
+        if (handles->freeSlot != kNoSlot) {
+            slot = handles->freeSlot;
+            handles->freeSlot = slots[slot].nextFree;
+        } else {
+            if (slots.size() >= kNoSlot) throw std::length_error("DoublyLinkedList: too many handles");
+            slots.push_back(HandleSlot{nullptr, 1, kNoSlot});
+            slot = static_cast<uint32_t>(slots.size() - 1);
+        }
+        try {
+            handles->slotOf.emplace(node, slot);
+        } catch (...) {
+            slots[slot].nextFree = handles->freeSlot;
+            handles->freeSlot = slot;
+            throw;
+        }
+        slots[slot].node = node;
+        return slot;
+    }
+
+    static constexpr bool cachesEnabled() { return !list_kernels::in_constant_evaluation(); }
+
+    LIST_CONSTEXPR void releaseSlot(Node* node) {
+        if (hasHandles()) releaseMappedSlot(node);
+    }
+
+    // releaseSlot() once a table exists; kept apart because the map is not
+    // usable in constant evaluation.
+    void releaseMappedSlot(Node* node) {
+        auto found = handles->slotOf.find(node);
+        if (found == handles->slotOf.end()) return;
+        uint32_t slot = found->second;
+        handles->slotOf.erase(found);
+        HandleSlot& s = handles->slots[slot];
+        s.node = nullptr;
+        if (++s.generation == 0) s.generation = 1;   // 0 marks a null Handle
+        s.nextFree = handles->freeSlot;
+        handles->freeSlot = slot;
+    }
+
+    // Nodes leaving for another list lose their handles: the slots belong
+    // to this list's table. chain is a detached chain linked through next.
+    void releaseChainSlots(Node* chain) {
+        if (!hasHandles()) return;
+        for (; chain; chain = chain->next) releaseSlot(chain);
+    }
+
+    Node* lookup(const Handle& h) const {
+        if (!handles || h.slot >= handles->slots.size()) return nullptr;
+        const HandleSlot& s = handles->slots[h.slot];
+        return s.generation == h.generation ? s.node : nullptr;
+    }
+
+    // Single logical pass that removes every node whose value satisfies
+    // doomed. Each maximal run of doomed nodes is unlinked with one relink
+    // and parked on a garbage chain, which is released in one go at the
+    // end; until then the doomed values stay alive, so doomed may refer to
+    // them (unique() compares against the last kept value, remove_all() may
+    // be handed a reference into the list).
+    template <typename Pred>
+    size_t sweep(Pred doomed) {
+        dropFinger();
+        invalidateHash();
+        Node* garbage = nullptr;
+        Node* garbageTail = nullptr;
+        size_t removed = 0;
+        try {
+            Node* cur = firstNode();
+            while (cur) {
+                LIST_STAT(++statsData.traversal_steps);
+                if (!doomed(cur->data)) {
+                    cur = nextOf(cur);
+                    continue;
+                }
+                Node* runFirst = cur;
+                Node* runLast = cur;
+                size_t n = 1;
+                for (cur = nextOf(cur); cur; cur = nextOf(cur)) {
+                    LIST_STAT(++statsData.traversal_steps);
+                    if (!doomed(cur->data)) break;
+                    runLast = cur;
+                    ++n;
+                }
+                Node* physFirst;
+                Node* physLast;
+                unlinkLogical(runFirst, runLast, n, &physFirst, &physLast);
+                if (garbageTail) garbageTail->next = physFirst;
+                else garbage = physFirst;
+                garbageTail = physLast;
+                removed += n;
+                // cur, if any, already tested as a keeper.
+                if (cur) cur = nextOf(cur);
+            }
+        } catch (...) {
+            releaseChain(garbage, removed);
+            throw;
+        }
+        releaseChain(garbage, removed);
+        return removed;
+    }
+
+    // Moves the first k (0 < k < sz) elements behind the last one by closing
+    // the chain into a ring and reopening it at the cut.
+    void moveFrontToBack(size_t k) {
+        using namespace list_kernels;
+        Node* cut = getNodeAt(k - 1);
+        if (hashLive()) {
+            // hashState = front ++ back; hash whichever side is shorter.
+            SeqHash front, back;
+            if (k <= sz - k) {
+                front = chainHash(firstNode(), cut);
+                back = strip_prefix(hashState, front);
+            } else {
+                back = chainHash(nextOf(cut), lastNode());
+                front = strip_suffix(hashState, back);
+            }
+            hashState = concat(back, front);
+        }
+        dropFinger();
+        tail->next = head;
+        head->prev = tail;
+        head = flipped ? cut : cut->next;
+        tail = head->prev;
+        head->prev = nullptr;
+        tail->next = nullptr;
+    }
+
+    // Takes over other's nodes; the caller has released ours and made sure
+    // the allocators can free each other's nodes.
+    LIST_CONSTEXPR void stealNodes(DoublyLinkedList& other) {
+        head = other.head;
+        tail = other.tail;
+        sz = other.sz;
+        flipped = other.flipped;
+        if (cachesEnabled()) {
+            hashState = other.hashState;
+            hashValid = other.hashValid;
+        } else {
+            hashValid = false;
+        }
+        hashTracking = other.hashTracking;
+        elementsExposed = other.elementsExposed;
+        delete handles;
+        handles = other.handles;
+        other.head = other.tail = nullptr;
+        other.sz = 0;
+        other.flipped = false;
+        other.dropFinger();
+        other.hashState = list_kernels::SeqHash();
+        other.hashValid = true;
+        other.elementsExposed = false;
+        other.handles = nullptr;
+    }
+
+    // Bulk copy behind the copy constructor and copy assignment: clones
+    // other's elements, in logical order, into a chain built off to the
+    // side and installs it with one relink, without the per-element hash,
+    // finger and size bookkeeping of push_back. The hash is copied along.
+    // *this must be empty; if a copy throws, the partial chain is freed and
+    // *this stays empty.
+    LIST_CONSTEXPR void copyNodesFrom(const DoublyLinkedList& other) {
+        Node* first = nullptr;
+        Node* last = nullptr;
+        size_t n = 0;
+        try {
+            for (const Node* cur = other.firstNode(); cur; cur = other.nextOf(cur)) {
+                Node* node = createNode(cur->data);
+                node->prev = last;
+                if (last) last->next = node;
+                else first = node;
+                last = node;
+                ++n;
+            }
+        } catch (...) {
+            releaseChain(first, n);
+            throw;
+        }
+        head = first;
+        tail = last;
+        sz = n;
+        LIST_STAT(if (sz > statsData.peak_size) statsData.peak_size = sz);
+        if (cachesEnabled()) {
+            hashState = other.hashState;
+            hashValid = other.hashValid;
+        } else {
+            hashValid = n == 0;
+        }
+    }
+
+    LIST_CONSTEXPR Node* getNodeAt(size_t index) {
+        return const_cast<Node*>(static_cast<const DoublyLinkedList*>(this)->getNodeAt(index));
+    }
+
+    // Walks from whichever of head, tail or the finger is closest. index is
+    // logical; the walk itself is done in physical positions.
+    LIST_CONSTEXPR const Node* getNodeAt(size_t index) const {
+        if (index >= sz) return nullptr;
+        if (flipped) index = sz - 1 - index;
+        const Node* cur;
+        size_t steps;
+        bool forward;
+        if (index <= sz - 1 - index) {
+            cur = head;
+            steps = index;
+            forward = true;
+        } else {
+            cur = tail;
+            steps = sz - 1 - index;
+            forward = false;
+        }
+        if (cachesEnabled() && fingerNode) {
+            size_t dist = index >= fingerIndex ? index - fingerIndex : fingerIndex - index;
+            if (dist < steps) {
+                cur = fingerNode;
+                steps = dist;
+                forward = index >= fingerIndex;
+            }
+        }
+        if (forward) {
+            for (size_t i = 0; i < steps; ++i) cur = cur->next;
+        } else {
+            for (size_t i = 0; i < steps; ++i) cur = cur->prev;
+        }
+        fingerNode = const_cast<Node*>(cur);
+        fingerIndex = index;
+        LIST_STAT(++statsData.indexed_lookups;
+                  statsData.indexed_walk_steps += steps;
+                  if (steps > statsData.longest_indexed_walk) statsData.longest_indexed_walk = steps);
+        return cur;
+    }
+
+    LIST_CONSTEXPR void dropFinger() const {
+        fingerNode = nullptr;
+    }
+
+    // Logical ends and neighbours.
+    LIST_CONSTEXPR Node* firstNode() const { return flipped ? tail : head; }
+    LIST_CONSTEXPR Node* lastNode() const { return flipped ? head : tail; }
+    LIST_CONSTEXPR Node* nextOf(const Node* node) const { return flipped ? node->prev : node->next; }
+    LIST_CONSTEXPR Node* prevOf(const Node* node) const { return flipped ? node->next : node->prev; }
+
+    // Swaps prev and next in every node of the chain first..last
+    // (following next), so that last becomes its first node.
+    static void reverseChain(Node* first, Node* last) {
+        for (Node* cur = first;;) {
+            Node* nxt = cur->next;
+            std::swap(cur->next, cur->prev);
+            if (cur == last) break;
+            cur = nxt;
+        }
+    }
+
+    // Reverses the physical order and toggles flipped: the logical order is
+    // unchanged, so iterators and element references stay valid. O(n).
+    void flipPhysical() {
+        if (head) reverseChain(head, tail);
+        std::swap(head, tail);
+        fingerIndex = sz ? sz - 1 - fingerIndex : 0;
+        flipped = !flipped;
+    }
+
+    // Physical counterparts of push_front / push_back for a created node.
+    LIST_CONSTEXPR void linkPhysicalFront(Node* node) {
+        if (!head) {
+            head = tail = node;
+        } else {
+            node->next = head;
+            head->prev = node;
+            head = node;
+        }
+        ++sz;
+        if (cachesEnabled()) ++fingerIndex;
+        hashNodeLinked(node);
+    }
+
+    LIST_CONSTEXPR void linkPhysicalBack(Node* node) {
+        if (!tail) {
+            head = tail = node;
+        } else {
+            node->prev = tail;
+            tail->next = node;
+            tail = node;
+        }
+        ++sz;
+        hashNodeLinked(node);
+    }
+
+    LIST_CONSTEXPR void linkFront(Node* node) {
+        if (flipped) linkPhysicalBack(node);
+        else linkPhysicalFront(node);
+    }
+
+    LIST_CONSTEXPR void linkBack(Node* node) {
+        if (flipped) linkPhysicalFront(node);
+        else linkPhysicalBack(node);
+    }
+
+    // Links node just before pos (logically), pos being neither null nor the
+    // first node, and leaves the finger on node.
+    LIST_CONSTEXPR void linkInside(Node* pos, Node* node) {
+        Node* before = flipped ? pos : pos->prev;
+        Node* after = flipped ? pos->next : pos;
+        node->prev = before;
+        node->next = after;
+        before->next = node;
+        after->prev = node;
+        ++sz;
+        fingerNode = node;
+        if (flipped && cachesEnabled()) ++fingerIndex;
+        hashNodeLinked(node);
+    }
+
+    LIST_CONSTEXPR bool unlinkPhysicalFront() {
+        if (!head) return false;
+        Node* del = head;
+        hashNodeUnlinking(del);
+        if (!cachesEnabled() || fingerNode == del) dropFinger();
+        else --fingerIndex;
+        head = head->next;
+        if (head) head->prev = nullptr;
+        else tail = nullptr;
+        destroyNode(del);
+        --sz;
+        return true;
+    }
+
+    LIST_CONSTEXPR bool unlinkPhysicalBack() {
+        if (!tail) return false;
+        Node* del = tail;
+        hashNodeUnlinking(del);
+        if (!cachesEnabled() || fingerNode == del) dropFinger();
+        tail = tail->prev;
+        if (tail) tail->next = nullptr;
+        else head = nullptr;
+        destroyNode(del);
+        --sz;
+        return true;
+    }
+
+    // Detaches the logical chain first..last of this list; returns it as a
+    // physical chain (first following next) in *physFirst / *physLast.
+    LIST_CONSTEXPR void unlinkLogical(Node* first, Node* last, size_t n, Node** physFirst, Node** physLast) {
+        *physFirst = flipped ? last : first;
+        *physLast = flipped ? first : last;
+        unlinkChain(*physFirst, *physLast, n);
+    }
+
+    // Links a physical chain, oriented as this list's order (next = logical
+    // next when not flipped), logically before pos (nullptr = at the end).
+    void linkLogicalBefore(Node* pos, Node* physFirst, Node* physLast, size_t n) {
+        if (!flipped) linkChainBefore(pos, physFirst, physLast, n);
+        else linkChainBefore(pos ? pos->next : head, physFirst, physLast, n);
+    }
+
+    // Reorients a physical chain detached from a list whose flipped bit was
+    // fromFlipped so that it can be linked into this one: when the
+    // directions differ the chain's links are swapped, O(chain length).
+    void orientChain(bool fromFlipped, Node*& physFirst, Node*& physLast) {
+        if (fromFlipped == flipped) return;
+        reverseChain(physFirst, physLast);
+        std::swap(physFirst, physLast);
+    }
+
+    LIST_CONSTEXPR void invalidateHash() {
+        hashValid = false;
+    }
+
+    // For non-const accessors: the caller may write through what it gets.
+    LIST_CONSTEXPR void exposeElements() {
+        elementsExposed = true;
+        hashValid = false;
+    }
+
+    static uint64_t elementHash(const T& value) {
+        if constexpr (list_kernels::is_std_hashable<T>::value) {
+            return list_kernels::mix_hash(std::hash<T>()(value));
+        } else {
+            return 0;
+        }
+    }
+
+    // Hash of the logical chain first..last.
+    list_kernels::SeqHash chainHash(const Node* first, const Node* last) const {
+        list_kernels::SeqHash h;
+        if (!first) return h;
+        for (const Node* cur = first;; cur = nextOf(cur)) {
+            h = list_kernels::concat(h, list_kernels::SeqHash::of(elementHash(cur->data)));
+            if (cur == last) break;
+        }
+        return h;
+    }
+
+    // Whether hashState should be updated in place for the edit about to
+    // happen. An untracked list just drops its cached hash.
+    LIST_CONSTEXPR bool hashLive() {
+        if (!cachesEnabled()) {
+            hashValid = false;
+            return false;
+        }
+        if (hashValid && !hashTracking) hashValid = false;
+        return hashValid;
+    }
+
+    // Hash of everything up to and including before (prefix = true) or of
+    // everything from after to the end (prefix = false), whichever is
+    // shorter: walks outwards from both at once, so the cost is the distance
+    // to the nearer end.
+    list_kernels::SeqHash sideHash(const Node* before, const Node* after, bool& prefix) const {
+        list_kernels::SeqHash pre, suf;
+        for (;;) {
+            if (!before) {
+                prefix = true;
+                return pre;
+            }
+            if (!after) {
+                prefix = false;
+                return suf;
+            }
+            pre = list_kernels::concat(list_kernels::SeqHash::of(elementHash(before->data)), pre);
+            suf = list_kernels::concat(suf, list_kernels::SeqHash::of(elementHash(after->data)));
+            before = prevOf(before);
+            after = nextOf(after);
+        }
+    }
+
+    // The logical chain first..last (hash chain) has just been linked in;
+    // hashState does not include it yet.
+    void hashLinked(const Node* first, const Node* last, const list_kernels::SeqHash& chain) {
+        using namespace list_kernels;
+        bool prefix;
+        SeqHash side = sideHash(prevOf(first), nextOf(last), prefix);
+        if (prefix) hashState = concat(concat(side, chain), strip_prefix(hashState, side));
+        else hashState = concat(concat(strip_suffix(hashState, side), chain), side);
+    }
+
+    // The logical chain first..last (hash chain) is about to be unlinked;
+    // hashState still includes it.
+    void hashUnlinking(const Node* first, const Node* last, const list_kernels::SeqHash& chain) {
+        using namespace list_kernels;
+        bool prefix;
+        SeqHash side = sideHash(prevOf(first), nextOf(last), prefix);
+        if (prefix) hashState = concat(side, strip_prefix(strip_prefix(hashState, side), chain));
+        else hashState = concat(strip_suffix(strip_suffix(hashState, side), chain), side);
+    }
+
+    LIST_CONSTEXPR void hashNodeLinked(const Node* node) {
+        if (hashLive()) hashLinked(node, node, list_kernels::SeqHash::of(elementHash(node->data)));
+    }
+
+    LIST_CONSTEXPR void hashNodeUnlinking(const Node* node) {
+        if (hashLive()) hashUnlinking(node, node, list_kernels::SeqHash::of(elementHash(node->data)));
+    }
+
+    // Unrolled kernels for bitwise comparable T. Each block of four compares
+    // is folded into one flag and tested once, and the two cursors are
+    // independent chains so their loads can overlap.
+    LIST_CONSTEXPR static bool equalChains(const Node* a, const Node* b, size_t n) {
+        for (; n >= 4; n -= 4) {
+            const Node* a1 = a->next;
+            const Node* b1 = b->next;
+            const Node* a2 = a1->next;
+            const Node* b2 = b1->next;
+            const Node* a3 = a2->next;
+            const Node* b3 = b2->next;
+            unsigned diff = (a->data != b->data) | (a1->data != b1->data) |
+                            (a2->data != b2->data) | (a3->data != b3->data);
+            if (diff) return false;
+            a = a3->next;
+            b = b3->next;
+        }
+        for (; n > 0; --n, a = a->next, b = b->next) {
+            if (a->data != b->data) return false;
+        }
+        return true;
+    }
+
+    // Advances a and b past their common prefix (at most n pairs) and
+    // returns how many equal pairs were skipped.
+    static size_t skipEqualPrefix(const Node*& a, const Node*& b, size_t n) {
+        size_t skipped = 0;
+        while (n - skipped >= 4) {
+            const Node* a1 = a->next;
+            const Node* b1 = b->next;
+            const Node* a2 = a1->next;
+            const Node* b2 = b1->next;
+            const Node* a3 = a2->next;
+            const Node* b3 = b2->next;
+            unsigned diff = (a->data != b->data) | (a1->data != b1->data) |
+                            (a2->data != b2->data) | (a3->data != b3->data);
+            if (diff) break;
+            a = a3->next;
+            b = b3->next;
+            skipped += 4;
+        }
+        while (skipped < n && a->data == b->data) {
+            a = a->next;
+            b = b->next;
+            ++skipped;
+        }
+        return skipped;
+    }
+
+    // Front and back cursors walking inwards over sz / 2 pairs.
+    bool palindromeKernel() const {
+        const Node* left = head;
+        const Node* right = tail;
+        size_t pairs = sz / 2;
+        for (; pairs >= 4; pairs -= 4) {
+            const Node* l1 = left->next;
+            const Node* r1 = right->prev;
+            const Node* l2 = l1->next;
+            const Node* r2 = r1->prev;
+            const Node* l3 = l2->next;
+            const Node* r3 = r2->prev;
+            unsigned diff = (left->data != right->data) | (l1->data != r1->data) |
+                            (l2->data != r2->data) | (l3->data != r3->data);
+            if (diff) return false;
+            left = l3->next;
+            right = r3->prev;
+        }
+        for (; pairs > 0; --pairs, left = left->next, right = right->prev) {
+            if (left->data != right->data) return false;
+        }
+        return true;
+    }
+
+    // True if no physically adjacent pair (x, y) has before(y, x), i.e. the
+    // physical order is ordered by before. Four pairs per block.
+    template <typename Before>
+    bool orderedKernel(Before before) const {
+        const Node* cur = head;
+        size_t pairs = sz - 1;
+        for (; pairs >= 4; pairs -= 4) {
+            const Node* n1 = cur->next;
+            const Node* n2 = n1->next;
+            const Node* n3 = n2->next;
+            const Node* n4 = n3->next;
+            unsigned bad = before(n1->data, cur->data) | before(n2->data, n1->data) |
+                           before(n3->data, n2->data) | before(n4->data, n3->data);
+            if (bad) return false;
+            LIST_STAT(statsData.traversal_steps += 4);
+            cur = n4;
+        }
+        for (; pairs > 0; --pairs, cur = cur->next) {
+            if (before(cur->next->data, cur->data)) return false;
+            LIST_STAT(++statsData.traversal_steps);
+        }
+        return true;
+    }
+
+    template <typename U, typename A>
+    friend LIST_CONSTEXPR bool operator==(const DoublyLinkedList<U, A>& lhs, const DoublyLinkedList<U, A>& rhs);
+    template <typename U, typename A>
+    friend bool operator<(const DoublyLinkedList<U, A>& lhs, const DoublyLinkedList<U, A>& rhs);
+
+    // Detaches the chain first..last (inclusive) and drops n from the size.
+    LIST_CONSTEXPR void unlinkChain(Node* first, Node* last, size_t n) {
+        dropFinger();
+        if (first->prev) first->prev->next = last->next;
+        else head = last->next;
+        if (last->next) last->next->prev = first->prev;
+        else tail = first->prev;
+        first->prev = last->next = nullptr;
+        sz -= n;
+    }
+
+    // Links a detached chain first..last in front of pos (nullptr = at the end).
+    void linkChainBefore(Node* pos, Node* first, Node* last, size_t n) {
+        dropFinger();
+        Node* before = pos ? pos->prev : tail;
+        first->prev = before;
+        last->next = pos;
+        if (before) before->next = first;
+        else head = first;
+        if (pos) pos->prev = last;
+        else tail = last;
+        sz += n;
+        LIST_STAT(if (sz > statsData.peak_size) statsData.peak_size = sz);
+    }
+
+    void printHelper(Node* cur, const std::string& sep = " ") const {
+        while (cur) {
+            std::cout << cur->data << sep;
+            cur = nextOf(cur);
+        }
+    }
+
+    void printReverseHelper(Node* cur, const std::string& sep = " ") const {
+        while (cur) {
+            std::cout << cur->data << sep;
+            cur = prevOf(cur);
+        }
+    }
+
+public:
+    // Iterators follow the list's current direction, so they stay valid
+    // across reverse() and normalize() and walk the new order afterwards.
+    template <bool IsConst>
+    class IteratorImpl {
+        using NodePtr = typename std::conditional<IsConst, const Node*, Node*>::type;
+        using Ref = typename std::conditional<IsConst, const T&, T&>::type;
+        using Ptr = typename std::conditional<IsConst, const T*, T*>::type;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Ptr;
+        using reference = Ref;
+
+        LIST_CONSTEXPR IteratorImpl(const DoublyLinkedList* l, NodePtr node) : list(l), current(node) {}
+
+        LIST_CONSTEXPR reference operator*() const { return current->data; }
+        LIST_CONSTEXPR pointer operator->() const { return &(current->data); }
+
+        LIST_CONSTEXPR IteratorImpl& operator++() {
+            current = list->nextOf(current);
+            return *this;
+        }
+
+        LIST_CONSTEXPR IteratorImpl operator++(int) {
+            IteratorImpl tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        LIST_CONSTEXPR IteratorImpl& operator--() {
+            current = current ? list->prevOf(current) : list->lastNode();
+            return *this;
+        }
+
+        LIST_CONSTEXPR IteratorImpl operator--(int) {
+            IteratorImpl tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        LIST_CONSTEXPR bool operator==(const IteratorImpl& other) const {
+            return current == other.current;
+        }
+
+        LIST_CONSTEXPR bool operator!=(const IteratorImpl& other) const {
+            return current != other.current;
+        }
+
+        LIST_CONSTEXPR operator IteratorImpl<true>() const {
+            return IteratorImpl<true>(list, current);
+        }
+
+    private:
+        friend class DoublyLinkedList;
+        const DoublyLinkedList* list;
+        NodePtr current;
+    };
+
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type = Allocator;
+
+    // One positional edit for apply_batch(). index refers to the list as it
+    // was before the batch; value is ignored for Erase.
+    struct Edit {
+        enum Op { Insert, Erase };
+
+        size_t index;
+        Op op;
+        T value;
+
+        static Edit insert(size_t index, T value) { return Edit{index, Insert, std::move(value)}; }
+        static Edit erase(size_t index) { return Edit{index, Erase, T()}; }
+    };
+
+    LIST_CONSTEXPR DoublyLinkedList() : DoublyLinkedList(Allocator()) {}
+
+    // Nodes come from alloc (rebound to the node type). Lists that splice,
+    // merge or move nodes between each other must have equal allocators,
+    // as with std::list.
+    LIST_CONSTEXPR explicit DoublyLinkedList(const Allocator& alloc)
+        : head(nullptr), tail(nullptr), sz(0), flipped(false), fingerNode(nullptr), fingerIndex(0),
+          hashState(), hashValid(true), hashTracking(false), elementsExposed(false),
+          nodeAlloc(alloc), handles(nullptr) {}
+
+    LIST_CONSTEXPR DoublyLinkedList(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : DoublyLinkedList(alloc) {
+        for (const auto& val : init) {
+            push_back(val);
+        }
+    }
+
+    // Copies, like moves, take over other's hash-tracking mode along with
+    // its hash, so a copy-constructed and a copy-assigned list agree.
+    LIST_CONSTEXPR DoublyLinkedList(const DoublyLinkedList& other)
+        : DoublyLinkedList(Allocator(NodeTraits::select_on_container_copy_construction(other.nodeAlloc))) {
+        copyNodesFrom(other);
+        hashTracking = other.hashTracking;
+    }
+
+    LIST_CONSTEXPR DoublyLinkedList& operator=(const DoublyLinkedList& other) {
+        if (this != &other) {
+            clear();
+            if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+                nodeAlloc = other.nodeAlloc;
+            }
+            copyNodesFrom(other);
+            hashTracking = other.hashTracking;
+        }
+        return *this;
+    }
+
+    LIST_CONSTEXPR DoublyLinkedList(DoublyLinkedList&& other) noexcept 
+        : head(other.head), tail(other.tail), sz(other.sz), flipped(other.flipped), fingerNode(nullptr), fingerIndex(0),
+          hashState(), hashValid(false), hashTracking(other.hashTracking), elementsExposed(other.elementsExposed),
+          nodeAlloc(std::move(other.nodeAlloc)), handles(other.handles) {
+        if (cachesEnabled()) {
+            hashState = other.hashState;
+            hashValid = other.hashValid;
+        }
+        other.head = other.tail = nullptr;
+        other.sz = 0;
+        other.flipped = false;
+        other.dropFinger();
+        other.hashState = list_kernels::SeqHash();
+        other.hashValid = true;
+        other.elementsExposed = false;
+        other.handles = nullptr;
+    }
+
+    // Steals the nodes when the allocator propagates or the two compare
+    // equal; otherwise (e.g. pmr lists on different resources) moves the
+    // elements one by one into nodes of our own.
+    LIST_CONSTEXPR DoublyLinkedList& operator=(DoublyLinkedList&& other) noexcept(
+        NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value) {
+        if (this != &other) {
+            clear();
+            if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+                nodeAlloc = std::move(other.nodeAlloc);
+                stealNodes(other);
+            } else if (NodeTraits::is_always_equal::value || nodeAlloc == other.nodeAlloc) {
+                stealNodes(other);
+            } else {
+                for (Node* cur = other.firstNode(); cur; cur = other.nextOf(cur)) {
+                    push_back(std::move(cur->data));
+                }
+                hashTracking = other.hashTracking;
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    LIST_CONSTEXPR ~DoublyLinkedList() {
+        clear();
+        if (handles) delete handles;
+#ifdef LINKED_LIST_ENABLE_STATS
+        if (!list_kernels::in_constant_evaluation() && list_stats_exporter()) {
+            list_stats_exporter()("DoublyLinkedList", statsData);
+        }
+#endif
+    }
+
+#ifdef LINKED_LIST_ENABLE_STATS
+    // Counters since construction or the last reset_stats(). splice_calls
+    // includes the splices merge() performs internally.
+    ListStats stats() const { return statsData; }
+
+    void reset_stats() {
+        statsData = ListStats();
+        statsData.peak_size = sz;
+    }
+
+    void export_stats(const char* label = "DoublyLinkedList") const {
+        if (list_stats_exporter()) list_stats_exporter()(label, statsData);
+    }
+#endif
+
+    // Non-const iterators and element references may be written through, so
+    // handing one out drops the hash (see hash()).
+    LIST_CONSTEXPR iterator begin() {
+        exposeElements();
+        return iterator(this, firstNode());
+    }
+    LIST_CONSTEXPR iterator end() {
+        exposeElements();
+        return iterator(this, nullptr);
+    }
+    LIST_CONSTEXPR const_iterator begin() const { return cbegin(); }
+    LIST_CONSTEXPR const_iterator end() const { return cend(); }
+    LIST_CONSTEXPR const_iterator cbegin() const { return const_iterator(this, firstNode()); }
+    LIST_CONSTEXPR const_iterator cend() const { return const_iterator(this, nullptr); }
+    LIST_CONSTEXPR reverse_iterator rbegin() { return reverse_iterator(end()); }
+    LIST_CONSTEXPR reverse_iterator rend() { return reverse_iterator(begin()); }
+    LIST_CONSTEXPR const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+    LIST_CONSTEXPR const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+
+    LIST_CONSTEXPR bool empty() const { return head == nullptr; }
+    LIST_CONSTEXPR size_t size() const { return sz; }
+
+    LIST_CONSTEXPR allocator_type get_allocator() const { return allocator_type(nodeAlloc); }
+
+    // Footprint of the list (see ListMemory.h). O(1). Nodes are counted as
+    // separate heap blocks whatever the allocator; free handle slots are
+    // slack, and node-to-slot map entries are estimated as one heap block
+    // each (a next pointer plus the key and slot).
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m;
+        list_memory::add_nodes(m, sz, sizeof(Node), sizeof(T));
+        m.overhead_bytes += sizeof(*this);
+        if (handles) {
+            size_t live = handles->slotOf.size();
+            const std::vector<HandleSlot>& slots = handles->slots;
+            m.overhead_bytes += sizeof(HandleTable) + live * sizeof(HandleSlot);
+            m.slack_bytes += (slots.size() - live) * sizeof(HandleSlot);
+            list_memory::add_heap_block(m, sizeof(HandleTable));
+            list_memory::add_vector_buffer(m, slots.size(), slots.capacity(), sizeof(HandleSlot));
+            list_memory::add_nodes(m, live, sizeof(void*) + sizeof(std::pair<const Node*, uint32_t>), 0);
+            size_t buckets = handles->slotOf.bucket_count();
+            m.overhead_bytes += buckets * sizeof(void*);
+            list_memory::add_heap_block(m, buckets * sizeof(void*));
+        }
+        return m;
+    }
+
+    LIST_CONSTEXPR T& front() {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        exposeElements();
+        return firstNode()->data;
+    }
+
+    LIST_CONSTEXPR const T& front() const {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return firstNode()->data;
+    }
+
+    LIST_CONSTEXPR T& back() {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        exposeElements();
+        return lastNode()->data;
+    }
+
+    LIST_CONSTEXPR const T& back() const {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        return lastNode()->data;
+    }
+
+    LIST_CONSTEXPR T& at(size_t index) {
+        if (index >= sz) throw std::out_of_range("at: index out of range");
+        exposeElements();
+        return getNodeAt(index)->data;
+    }
+
+    LIST_CONSTEXPR const T& at(size_t index) const {
+        if (index >= sz) throw std::out_of_range("at: index out of range");
+        return getNodeAt(index)->data;
+    }
+
+    LIST_CONSTEXPR T& operator[](size_t index) {
+        return at(index);
+    }
+
+    LIST_CONSTEXPR const T& operator[](size_t index) const {
+        return at(index);
+    }
+
+    // Modifiers
+    LIST_CONSTEXPR void push_front(const T& value) {
+        linkFront(createNode(value));
+    }
+
+    LIST_CONSTEXPR void push_front(T&& value) {
+        linkFront(createNode(std::move(value)));
+    }
+
+    LIST_CONSTEXPR void push_back(const T& value) {
+        linkBack(createNode(value));
+    }
+
+    LIST_CONSTEXPR void push_back(T&& value) {
+        linkBack(createNode(std::move(value)));
+    }
+
+    template <typename... Args>
+    LIST_CONSTEXPR void emplace_front(Args&&... args) {
+        linkFront(createNode(T(std::forward<Args>(args)...)));
+    }
+
+    template <typename... Args>
+    LIST_CONSTEXPR void emplace_back(Args&&... args) {
+        linkBack(createNode(T(std::forward<Args>(args)...)));
+    }
+
+    LIST_CONSTEXPR bool insert_at(size_t index, const T& value) {
+        if (index > sz) return false;
+        if (index == 0) {
+            push_front(value);
+            return true;
+        }
+        if (index == sz) {
+            push_back(value);
+            return true;
+        }
+        Node* cur = getNodeAt(index);
+        linkInside(cur, createNode(value));
+        return true;
+    }
+
+    LIST_CONSTEXPR bool insert_at(size_t index, T&& value) {
+        if (index > sz) return false;
+        if (index == 0) {
+            push_front(std::move(value));
+            return true;
+        }
+        if (index == sz) {
+            push_back(std::move(value));
+            return true;
+        }
+        Node* cur = getNodeAt(index);
+        linkInside(cur, createNode(std::move(value)));
+        return true;
+    }
+
+    template <typename... Args>
+    LIST_CONSTEXPR bool emplace_at(size_t index, Args&&... args) {
+        if (index > sz) return false;
+        if (index == 0) {
+            emplace_front(std::forward<Args>(args)...);
+            return true;
+        }
+        if (index == sz) {
+            emplace_back(std::forward<Args>(args)...);
+            return true;
+        }
+        Node* cur = getNodeAt(index);
+        linkInside(cur, createNode(T(std::forward<Args>(args)...)));
+        return true;
+    }
+
+    bool insert_before_value(const T& value, const T& before) {
+        dropFinger();
+        Node* cur = firstNode();
+        while (cur && cur->data != before) {
+            LIST_STAT(++statsData.traversal_steps);
+            cur = nextOf(cur);
+        }
+        if (!cur) return false;
+        if (cur == firstNode()) {
+            push_front(value);
+            return true;
+        }
+        linkInside(cur, createNode(value));
+        dropFinger();
+        return true;
+    }
+
+    bool insert_after_value(const T& value, const T& after) {
+        dropFinger();
+        Node* cur = firstNode();
+        while (cur && cur->data != after) {
+            LIST_STAT(++statsData.traversal_steps);
+            cur = nextOf(cur);
+        }
+        if (!cur) return false;
+        if (cur == lastNode()) {
+            push_back(value);
+            return true;
+        }
+        linkInside(nextOf(cur), createNode(value));
+        dropFinger();
+        return true;
+    }
+
+    LIST_CONSTEXPR bool pop_front() {
+        return flipped ? unlinkPhysicalBack() : unlinkPhysicalFront();
+    }
+
+    LIST_CONSTEXPR bool pop_back() {
+        return flipped ? unlinkPhysicalFront() : unlinkPhysicalBack();
+    }
+
+    LIST_CONSTEXPR bool erase_at(size_t index) {
+        if (index >= sz) return false;
+        if (index == 0) return pop_front();
+        if (index == sz - 1) return pop_back();
+        Node* cur = getNodeAt(index);
+        hashNodeUnlinking(cur);
+        cur->prev->next = cur->next;
+        cur->next->prev = cur->prev;
+        // The finger keeps its physical position, now held by cur->next.
+        fingerNode = cur->next;
+        destroyNode(cur);
+        --sz;
+        return true;
+    }
+
+    LIST_CONSTEXPR iterator erase(const_iterator pos) {
+        dropFinger();
+        if (!pos.current) return iterator(this, nullptr);
+        Node* node = const_cast<Node*>(pos.current);
+        Node* next = nextOf(node);
+        hashNodeUnlinking(node);
+        unlinkChain(node, node, 1);
+        destroyNode(node);
+        if (next) exposeElements();
+        return iterator(this, next);
+    }
+
+    // Erases [first, last) and returns last.
+    LIST_CONSTEXPR iterator erase(const_iterator first, const_iterator last) {
+        dropFinger();
+        Node* end = const_cast<Node*>(last.current);
+        if (first == last) return iterator(this, end);
+        exposeElements();
+        Node* start = const_cast<Node*>(first.current);
+        Node* stop = end ? prevOf(end) : lastNode();
+        size_t n = 0;
+        for (Node* cur = start;; cur = nextOf(cur)) {
+            LIST_STAT(++statsData.traversal_steps);
+            ++n;
+            if (cur == stop) break;
+        }
+        Node* physFirst;
+        Node* physLast;
+        unlinkLogical(start, stop, n, &physFirst, &physLast);
+        releaseChain(physFirst, n);
+        return iterator(this, end);
+    }
+
+    bool remove_first(const T& value) {
+        dropFinger();
+        Node* cur = firstNode();
+        while (cur && cur->data != value) {
+            LIST_STAT(++statsData.traversal_steps);
+            cur = nextOf(cur);
+        }
+        if (!cur) return false;
+        erase(const_iterator(this, cur));
+        return true;
+    }
+
+    // value may refer to an element of this list.
+    int remove_all(const T& value) {
+        return static_cast<int>(sweep([&value](const T& v) { return v == value; }));
+    }
+
+    // Removes every element for which pred returns true in a single pass,
+    // calling pred once per element in list order. Runs of removed nodes
+    // are unlinked together and freed in a batch after the pass.
+    template <typename Pred>
+    size_t erase_if(Pred pred) {
+        return sweep(pred);
+    }
+
+    // Applies many positional inserts and erases in one forward walk, for
+    // O(n + k log k) instead of O(n * k) with repeated insert_at/erase_at.
+    //
+    // Every index refers to the list before the batch, so callers never
+    // adjust for earlier edits. An insert at i lands in front of the
+    // original i-th element (i == size() appends), and inserts sharing an
+    // index keep their relative order. Erasing the same index twice or an
+    // out-of-range index is ignored. Returns the number of edits applied.
+    size_t apply_batch(std::vector<Edit> edits) {
+        std::stable_sort(edits.begin(), edits.end(), [](const Edit& a, const Edit& b) {
+            if (a.index != b.index) return a.index < b.index;
+            return a.op == Edit::Insert && b.op == Edit::Erase;
+        });
+        normalize();
+        invalidateHash();
+        size_t origSize = sz;
+        size_t applied = 0;
+        Node* cur = head;  // original element at position pos, or nullptr at the end
+        size_t pos = 0;
+        for (Edit& edit : edits) {
+            if (edit.index > origSize) break;
+            if (edit.index < pos) continue;
+            while (pos < edit.index) {
+                LIST_STAT(++statsData.traversal_steps);
+                cur = cur->next;
+                ++pos;
+            }
+            if (edit.op == Edit::Insert) {
+                Node* node = createNode(std::move(edit.value));
+                linkChainBefore(cur, node, node, 1);
+            } else {
+                if (!cur) continue;
+                Node* nxt = cur->next;
+                unlinkChain(cur, cur, 1);
+                destroyNode(cur);
+                cur = nxt;
+                ++pos;
+            }
+            ++applied;
+        }
+        return applied;
+    }
+
+    // Inserts the elements of [first, last) into a list that is already
+    // sorted ascending, keeping it sorted. The new elements are sorted
+    // (O(k log k)) and then merged in during a single walk of the list;
+    // each one goes after any equal elements already present.
+    template <typename InputIt>
+    void insert_sorted_range(InputIt first, InputIt last) {
+        std::vector<T> batch(first, last);
+        if (batch.empty()) return;
+        std::stable_sort(batch.begin(), batch.end());
+        normalize();
+        invalidateHash();
+        Node* cur = head;
+        for (T& val : batch) {
+            while (cur && !(val < cur->data)) {
+                LIST_STAT(++statsData.traversal_steps);
+                cur = cur->next;
+            }
+            Node* node = createNode(std::move(val));
+            linkChainBefore(cur, node, node, 1);
+        }
+    }
+
+    // O(1) when releaseIsNoop() (trivially destructible T on a monotonic
+    // arena): the nodes are left for the arena to reclaim.
+    LIST_CONSTEXPR void clear() {
+        dropFinger();
+        releaseChain(head, sz);
+        head = tail = nullptr;
+        sz = 0;
+        flipped = false;
+        hashState = list_kernels::SeqHash();
+        hashValid = true;
+        elementsExposed = false;
+    }
+
+    // O(1): toggles the direction bit; no node is touched. Iterators stay
+    // valid and walk the reversed order.
+    LIST_CONSTEXPR void reverse() {
+        if (sz <= 1) return;
+        flipped = !flipped;
+        if (cachesEnabled() && hashValid) hashState = hashState.reversed();
+    }
+
+    // Rewrites the links so that the physical order (head to tail along
+    // next) is the logical order again. O(n) after an odd number of
+    // reverse() calls, O(1) otherwise; the elements' order is unchanged.
+    void normalize() {
+        if (!flipped) return;
+        LIST_STAT(statsData.traversal_steps += sz);
+        flipPhysical();
+    }
+
+    // True if the list is currently stored back to front (see normalize()).
+    bool is_flipped() const { return flipped; }
+
+    void sort_ascending() {
+        if (sz <= 1) return;
+        std::vector<T> vec = to_vector();
+        std::sort(vec.begin(), vec.end());
+        clear();
+        for (const auto& val : vec) {
+            push_back(val);
+        }
+    }
+
+    void sort_descending() {
+        if (sz <= 1) return;
+        std::vector<T> vec = to_vector();
+        std::sort(vec.begin(), vec.end(), std::greater<T>());
+        clear();
+        for (const auto& val : vec) {
+            push_back(val);
+        }
+    }
+
+    void remove_duplicates() {
+        dropFinger();
+        normalize();
+        invalidateHash();
+        Node* cur = head;
+        while (cur) {
+            Node* inner = cur->next;
+            while (inner) {
+                if (inner->data == cur->data) {
+                    Node* del = inner;
+                    LIST_STAT(++statsData.traversal_steps);
+                    inner = inner->next;
+                    if (del == tail) pop_back();
+                    else {
+                        del->prev->next = del->next;
+                        del->next->prev = del->prev;
+                        destroyNode(del);
+                        --sz;
+                    }
+                } else {
+                    LIST_STAT(++statsData.traversal_steps);
+                    inner = inner->next;
+                }
+            }
+            LIST_STAT(++statsData.traversal_steps);
+            cur = cur->next;
+        }
+    }
+
+    // Drops each element equal to the one kept before it, in one pass.
+    void unique() {
+        if (sz <= 1) return;
+        const T* kept = nullptr;
+        sweep([&kept](const T& v) {
+            if (kept && *kept == v) return true;
+            kept = &v;
+            return false;
+        });
+    }
+
+    void append(DoublyLinkedList& other) {
+        if (other.empty()) return;
+        Node* cur = other.firstNode();
+        while (cur) {
+            push_back(cur->data);
+            LIST_STAT(++statsData.traversal_steps);
+            cur = other.nextOf(cur);
+        }
+    }
+
+    // Inserts value logically before pos and returns a handle to it.
+    Handle insert(const_iterator pos, const T& value) {
+        return emplace(pos, value);
+    }
+
+    Handle insert(const_iterator pos, T&& value) {
+        return emplace(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    Handle emplace(const_iterator pos, Args&&... args) {
+        Node* node = createNode(T(std::forward<Args>(args)...));
+        uint32_t slot;
+        try {
+            slot = acquireSlot(node);
+        } catch (...) {
+            destroyNode(node);
+            throw;
+        }
+        linkLogicalBefore(const_cast<Node*>(pos.current), node, node, 1);
+        hashNodeLinked(node);
+        return Handle{slot, handles->slots[slot].generation};
+    }
+
+    // Handle to the element at it (end() gives a null handle). Repeated
+    // calls for one element return the same handle.
+    Handle handle_of(const_iterator it) {
+        if (!it.current) return Handle();
+        uint32_t slot = acquireSlot(const_cast<Node*>(it.current));
+        return Handle{slot, handles->slots[slot].generation};
+    }
+
+    // The element named by h, or nullptr once it is gone. O(1).
+    T* get(const Handle& h) {
+        Node* node = lookup(h);
+        if (!node) return nullptr;
+        exposeElements();
+        return &node->data;
+    }
+
+    const T* get(const Handle& h) const {
+        const Node* node = lookup(h);
+        return node ? &node->data : nullptr;
+    }
+
+    bool contains(const Handle& h) const { return lookup(h) != nullptr; }
+
+    // Iterator to the element named by h, or end().
+    iterator iterator_to(const Handle& h) {
+        exposeElements();
+        return iterator(this, lookup(h));
+    }
+
+    const_iterator iterator_to(const Handle& h) const { return const_iterator(this, lookup(h)); }
+
+    // Erases the element named by h in O(1); false if it is already gone.
+    bool erase(const Handle& h) {
+        Node* node = lookup(h);
+        if (!node) return false;
+        erase(const_iterator(this, node));
+        return true;
+    }
+
+    size_t handle_count() const { return handles ? handles->slotOf.size() : 0; }
+
+    // Moves all of other's nodes in front of pos, like std::list::splice.
+    // O(1) when both lists have the same direction; otherwise whichever of
+    // the two is shorter is flipped physically first.
+    void splice(const_iterator pos, DoublyLinkedList& other) {
+        LIST_STAT(++statsData.splice_calls);
+        if (this == &other || other.empty()) return;
+        if (flipped != other.flipped) {
+            if (sz < other.sz) flipPhysical();
+            else other.flipPhysical();
+        }
+        Node* first = other.firstNode();
+        Node* last = other.lastNode();
+        size_t n = other.sz;
+        bool live = hashLive();
+        list_kernels::SeqHash chain;
+        if (live) chain = other.hashValid ? other.hashState : other.chainHash(first, last);
+        Node* physFirst = other.head;
+        Node* physLast = other.tail;
+        other.unlinkChain(physFirst, physLast, n);
+        other.releaseChainSlots(physFirst);
+        other.hashState = list_kernels::SeqHash();
+        other.hashValid = true;
+        other.flipped = false;
+        elementsExposed = elementsExposed || other.elementsExposed;
+        other.elementsExposed = false;
+        linkLogicalBefore(const_cast<Node*>(pos.current), physFirst, physLast, n);
+        if (live) hashLinked(first, last, chain);
+    }
+
+    // Moves the single node at it from other in front of pos.
+    void splice(const_iterator pos, DoublyLinkedList& other, const_iterator it) {
+        LIST_STAT(++statsData.splice_calls);
+        Node* node = const_cast<Node*>(it.current);
+        if (!node || node == pos.current) return;
+        other.hashNodeUnlinking(node);
+        other.unlinkChain(node, node, 1);
+        if (this != &other) other.releaseSlot(node);
+        elementsExposed = elementsExposed || other.elementsExposed;
+        linkLogicalBefore(const_cast<Node*>(pos.current), node, node, 1);
+        hashNodeLinked(node);
+    }
+
+    // Moves [first, last) from other in front of pos. pos must not lie
+    // inside the range when other is *this. Between lists of opposite
+    // direction the moved nodes are relinked, which the O(range) count
+    // already pays for.
+    void splice(const_iterator pos, DoublyLinkedList& other, const_iterator first, const_iterator last) {
+        LIST_STAT(++statsData.splice_calls);
+        if (first == last) return;
+        Node* chainFirst = const_cast<Node*>(first.current);
+        Node* chainLast = last.current ? other.prevOf(last.current) : other.lastNode();
+        size_t n = 0;
+        list_kernels::SeqHash chain;
+        bool liveHere = false, liveThere = false;
+        if (this != &other) {
+            for (Node* cur = chainFirst; cur != last.current; cur = other.nextOf(cur)) ++n;
+            liveHere = hashLive();
+            liveThere = other.hashLive();
+            if (liveHere || liveThere) chain = other.chainHash(chainFirst, chainLast);
+        } else {
+            invalidateHash();
+        }
+        if (liveThere) other.hashUnlinking(chainFirst, chainLast, chain);
+        Node* physFirst;
+        Node* physLast;
+        other.unlinkLogical(chainFirst, chainLast, n, &physFirst, &physLast);
+        if (this != &other) other.releaseChainSlots(physFirst);
+        elementsExposed = elementsExposed || other.elementsExposed;
+        orientChain(other.flipped, physFirst, physLast);
+        linkLogicalBefore(const_cast<Node*>(pos.current), physFirst, physLast, n);
+        if (liveHere) hashLinked(chainFirst, chainLast, chain);
+    }
+
+    // Detaches the first min(k, size()) nodes into a new list without
+    // copying. Walks from whichever end is closer to the cut.
+    DoublyLinkedList take_front(size_t k) {
+        DoublyLinkedList out(get_allocator());
+        if (k == 0 || !head) return out;
+        if (k >= sz) {
+            releaseChainSlots(head);
+            std::swap(head, out.head);
+            std::swap(tail, out.tail);
+            std::swap(sz, out.sz);
+            std::swap(flipped, out.flipped);
+            std::swap(hashState, out.hashState);
+            std::swap(hashValid, out.hashValid);
+            std::swap(elementsExposed, out.elementsExposed);
+            dropFinger();
+            return out;
+        }
+        Node* last = getNodeAt(k - 1);
+        Node* first = firstNode();
+        if (hashLive()) {
+            out.hashState = chainHash(first, last);
+            hashUnlinking(first, last, out.hashState);
+        } else {
+            out.hashValid = false;
+        }
+        Node* physFirst;
+        Node* physLast;
+        unlinkLogical(first, last, k, &physFirst, &physLast);
+        releaseChainSlots(physFirst);
+        out.elementsExposed = elementsExposed;
+        out.flipped = flipped;
+        out.linkChainBefore(nullptr, physFirst, physLast, k);
+        return out;
+    }
+
+    void merge(DoublyLinkedList& other) {
+        LIST_STAT(++statsData.merge_calls);
+        if (this == &other || other.empty()) return;
+        invalidateHash();
+        other.invalidateHash();
+        
+        if (empty()) {
+            splice(cbegin(), other);
+            return;
+        }
+        
+        const_iterator it1 = cbegin();
+        const_iterator it2 = other.cbegin();
+        
+        while (it2 != other.cend()) {
+            if (it1 == cend()) {
+                splice(cend(), other);
+                return;
+            }
+            if (*it2 < *it1) {
+                const_iterator next = it2;
+                ++next;
+                splice(it1, other, it2);
+                it2 = next;
+            } else {
+                ++it1;
+            }
+        }
+    }
+
+    void swap_nodes(size_t idx1, size_t idx2) {
+        if (idx1 >= sz || idx2 >= sz || idx1 == idx2) return;
+        Node* n1 = getNodeAt(idx1);
+        Node* n2 = getNodeAt(idx2);
+        std::swap(n1->data, n2->data);
+        invalidateHash();
+    }
+
+    // Both rotations walk to the cut (O(min(k, n - k))) and then relink the
+    // ends; no element is copied and no node is freed or allocated.
+    void rotate_left(size_t k) {
+        if (sz <= 1) return;
+        k %= sz;
+        if (k != 0) moveFrontToBack(k);
+    }
+
+    void rotate_right(size_t k) {
+        if (sz <= 1) return;
+        k %= sz;
+        if (k != 0) moveFrontToBack(sz - k);
+    }
+
+    LIST_CONSTEXPR bool contains(const T& value) const {
+        return std::find(begin(), end(), value) != end();
+    }
+
+    LIST_CONSTEXPR int find_first_index(const T& value) const {
+        Node* cur = firstNode();
+        int index = 0;
+        while (cur) {
+            if (cur->data == value) return index;
+            LIST_STAT(++statsData.traversal_steps);
+            cur = nextOf(cur);
+            ++index;
+        }
+        return -1;
+    }
+
+    int find_last_index(const T& value) const {
+        Node* cur = lastNode();
+        int index = sz - 1;
+        while (cur) {
+            if (cur->data == value) return index;
+            LIST_STAT(++statsData.traversal_steps);
+            cur = prevOf(cur);
+            --index;
+        }
+        return -1;
+    }
+
+    int count_occurrences(const T& value) const {
+        int count = 0;
+        Node* cur = head;
+        while (cur) {
+            if (cur->data == value) ++count;
+            LIST_STAT(++statsData.traversal_steps);
+            cur = cur->next;
+        }
+        return count;
+    }
+
+    T max_value() const {
+        if (empty()) throw std::out_of_range("max_value: list is empty");
+        T mx = head->data;
+        Node* cur = head->next;
+        while (cur) {
+            if (cur->data > mx) mx = cur->data;
+            LIST_STAT(++statsData.traversal_steps);
+            cur = cur->next;
+        }
+        return mx;
+    }
+
+    T min_value() const {
+        if (empty()) throw std::out_of_range("min_value: list is empty");
+        T mn = head->data;
+        Node* cur = head->next;
+        while (cur) {
+            if (cur->data < mn) mn = cur->data;
+            LIST_STAT(++statsData.traversal_steps);
+            cur = cur->next;
+        }
+        return mn;
+    }
+
+    T median() const {
+        if (empty()) throw std::out_of_range("median: list is empty");
+        size_t mid = sz / 2;
+        if (sz % 2 == 1) {
+            return at(mid);
+        }
+        T val1 = at(mid - 1);
+        T val2 = at(mid);
+        return (val1 + val2) / 2;
+    }
+
+    DoublyLinkedList get_sublist(size_t start, size_t end) const {
+        DoublyLinkedList sub(get_allocator());
+        if (start >= sz || end > sz || start > end) return sub;
+        for (size_t i = start; i < end; ++i) {
+            sub.push_back(at(i));
+        }
+        return sub;
+    }
+
+    // Order-sensitive 64-bit hash of the elements, built from std::hash<T>.
+    // Without tracking it is computed on first use and cached until the next
+    // change. With enable_hash_tracking() it is kept up to date instead:
+    // push/pop at either end, whole-list splice, reverse and clear update it
+    // in O(1); a single insert or erase in the middle, or a range splice,
+    // costs O(distance to the nearer end) on top of the edit. Bulk edits
+    // (erase_if, merge, apply_batch, ...) and non-const element access still
+    // drop it until the next call. Writes through references or iterators
+    // obtained before the call are not noticed, so a hash taken while such
+    // a reference is alive may be stale; operator== consults it only for
+    // tracked lists that have never handed such a reference out.
+    uint64_t hash() const {
+        static_assert(list_kernels::is_std_hashable<T>::value, "hash() needs std::hash<T>");
+        if (!hashValid) {
+            hashState = chainHash(firstNode(), lastNode());
+            LIST_STAT(statsData.traversal_steps += sz);
+            hashValid = true;
+        }
+        return hashState.fwd;
+    }
+
+    // hash() computed afresh in O(n), without reading or filling the cache,
+    // for callers that may share the list with other readers.
+    uint64_t compute_hash() const {
+        static_assert(list_kernels::is_std_hashable<T>::value, "compute_hash() needs std::hash<T>");
+        return chainHash(firstNode(), lastNode()).fwd;
+    }
+
+    void enable_hash_tracking() {
+        static_assert(list_kernels::is_std_hashable<T>::value, "hash tracking needs std::hash<T>");
+        hashTracking = true;
+    }
+
+    void disable_hash_tracking() { hashTracking = false; }
+
+    bool hash_tracking() const { return hashTracking; }
+
+    bool is_palindrome() const {
+        if (sz <= 1) return true;
+        if constexpr (list_kernels::is_bitwise_comparable<T>::value) return palindromeKernel();
+        Node* left = head;
+        Node* right = tail;
+        while (left != right && left->prev != right) {
+            if (left->data != right->data) return false;
+            left = left->next;
+            right = right->prev;
+        }
+        return true;
+    }
+
+    void replace_all(const T& old_val, const T& new_val) {
+        invalidateHash();
+        Node* cur = head;
+        while (cur) {
+            if (cur->data == old_val) {
+                cur->data = new_val;
+            }
+            LIST_STAT(++statsData.traversal_steps);
+            cur = cur->next;
+        }
+    }
+
+    bool is_sorted_ascending() const {
+        if (sz <= 1) return true;
+        if constexpr (list_kernels::is_bitwise_comparable<T>::value) {
+            if (flipped) return orderedKernel([](const T& a, const T& b) { return a > b; });
+            return orderedKernel([](const T& a, const T& b) { return a < b; });
+        }
+        Node* cur = firstNode();
+        while (nextOf(cur)) {
+            if (cur->data > nextOf(cur)->data) return false;
+            LIST_STAT(++statsData.traversal_steps);
+            cur = nextOf(cur);
+        }
+        return true;
+    }
+
+    bool is_sorted_descending() const {
+        if (sz <= 1) return true;
+        if constexpr (list_kernels::is_bitwise_comparable<T>::value) {
+            if (flipped) return orderedKernel([](const T& a, const T& b) { return a < b; });
+            return orderedKernel([](const T& a, const T& b) { return a > b; });
+        }
+        Node* cur = firstNode();
+        while (nextOf(cur)) {
+            if (cur->data < nextOf(cur)->data) return false;
+            LIST_STAT(++statsData.traversal_steps);
+            cur = nextOf(cur);
+        }
+        return true;
+    }
+
+    T sum() const {
+        if (empty()) throw std::out_of_range("sum: list is empty");
+        T total = T();
+        Node* cur = firstNode();
+        while (cur) {
+            total += cur->data;
+            LIST_STAT(++statsData.traversal_steps);
+            cur = nextOf(cur);
+        }
+        return total;
+    }
+
+    double average() const {
+        if (empty()) throw std::out_of_range("average: list is empty");
+        return static_cast<double>(sum()) / sz;
+    }
+
+    LIST_CONSTEXPR std::vector<T> to_vector() const {
+        std::vector<T> v;
+        v.reserve(sz);
+        Node* cur = firstNode();
+        while (cur) {
+            v.push_back(cur->data);
+            LIST_STAT(++statsData.traversal_steps);
+            cur = nextOf(cur);
+        }
+        return v;
+    }
+
+    void print_forward() const {
+        if (empty()) {
+            std::cout << "[ empty ]\n";
+            return;
+        }
+        std::cout << "[ ";
+        printHelper(firstNode());
+        std::cout << "]\n";
+    }
+
+    void print_backward() const {
+        if (empty()) {
+            std::cout << "[ empty ]\n";
+            return;
+        }
+        std::cout << "[ ";
+        printReverseHelper(lastNode());
+        std::cout << "]\n";
+    }
+
+    void print_detailed() const {
+        if (empty()) {
+            std::cout << "List: [ empty ]\n\n";
+            return;
+        }
+        std::cout << "Forward:  [ ";
+        printHelper(firstNode());
+        std::cout << "]\n";
+        std::cout << "Backward: [ ";
+        printReverseHelper(lastNode());
+        std::cout << "]\n";
+        std::cout << "Size: " << sz << " | Front: " << front() << " | Back: " << back() << "\n\n";
+    }
+
+    void print_with_separator(const std::string& sep = " -> ") const {
+        if (empty()) {
+            std::cout << "[ empty ]\n";
+            return;
+        }
+        Node* cur = firstNode();
+        std::cout << "[";
+        while (cur) {
+            std::cout << cur->data;
+            if (nextOf(cur)) std::cout << sep;
+            LIST_STAT(++statsData.traversal_steps);
+            cur = nextOf(cur);
+        }
+        std::cout << "]\n";
+    }
+};
+
+// Exits early on a size mismatch, and on a hash mismatch when both lists
+// track their hash and neither has handed out a mutable reference or
+// iterator (elementsExposed), since only then is the hash known to be
+// current. Otherwise it compares the elements; when they are equal and
+// only one side has a trusted hash, the other takes a copy of it, so the
+// next comparison against a changed list can exit in O(1).
+template <typename T, typename A>
+LIST_CONSTEXPR bool operator==(const DoublyLinkedList<T, A>& lhs, const DoublyLinkedList<T, A>& rhs) {
+    using List = DoublyLinkedList<T, A>;
+    if (lhs.size() != rhs.size()) return false;
+    if (&lhs == &rhs) return true;
+    bool lhsTrusted = false, rhsTrusted = false;
+    if (List::cachesEnabled()) {
+        lhsTrusted = lhs.hashTracking && !lhs.elementsExposed && lhs.hashValid;
+        rhsTrusted = rhs.hashTracking && !rhs.elementsExposed && rhs.hashValid;
+        if (lhsTrusted && rhsTrusted && lhs.hashState.fwd != rhs.hashState.fwd) return false;
+    }
+    bool equal;
+    if constexpr (list_kernels::is_bitwise_comparable<T>::value) {
+        if (!lhs.flipped && !rhs.flipped) equal = List::equalChains(lhs.head, rhs.head, lhs.sz);
+        else equal = std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    } else {
+        equal = std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    if (equal && lhsTrusted != rhsTrusted) {
+        const List& from = lhsTrusted ? lhs : rhs;
+        const List& to = lhsTrusted ? rhs : lhs;
+        if (to.hashTracking && !to.elementsExposed) {
+            to.hashState = from.hashState;
+            to.hashValid = true;
+        }
+    }
+    return equal;
+}
+
+template <typename T, typename A>
+LIST_CONSTEXPR bool operator!=(const DoublyLinkedList<T, A>& lhs, const DoublyLinkedList<T, A>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename A>
+bool operator<(const DoublyLinkedList<T, A>& lhs, const DoublyLinkedList<T, A>& rhs) {
+    if constexpr (list_kernels::is_bitwise_comparable<T>::value) {
+        if (!lhs.flipped && !rhs.flipped) {
+            using Node = typename DoublyLinkedList<T, A>::Node;
+            const Node* a = lhs.head;
+            const Node* b = rhs.head;
+            size_t common = std::min(lhs.sz, rhs.sz);
+            if (DoublyLinkedList<T, A>::skipEqualPrefix(a, b, common) == common) return lhs.sz < rhs.sz;
+            return a->data < b->data;
+        }
+    }
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename A>
+bool operator<=(const DoublyLinkedList<T, A>& lhs, const DoublyLinkedList<T, A>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, typename A>
+bool operator>(const DoublyLinkedList<T, A>& lhs, const DoublyLinkedList<T, A>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, typename A>
+bool operator>=(const DoublyLinkedList<T, A>& lhs, const DoublyLinkedList<T, A>& rhs) {
+    return !(lhs < rhs);
+}
+
+namespace std {
+// list.hash(), with its caveat: a list written through a reference or
+// iterator taken before the hash was cached can hash stale. Do not mutate
+// a list that is a key in a hashed container through such references.
+template <typename T, typename A>
+struct hash<DoublyLinkedList<T, A>> {
+    size_t operator()(const DoublyLinkedList<T, A>& list) const { return static_cast<size_t>(list.hash()); }
+};
+} // namespace std
+
+// Not a global namespace pmr: with `using namespace std;` in effect, as in
+// the demo programs, an unqualified pmr:: would be ambiguous with std::pmr.
+namespace list_pmr {
+// DoublyLinkedList whose nodes come from a std::pmr::memory_resource. On a
+// std::pmr::monotonic_buffer_resource, clearing or destroying a list of
+// trivially destructible T is O(1).
+template <typename T>
+using DoublyLinkedList = ::DoublyLinkedList<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace list_pmr
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Epoch-based reclamation (EBR) for read-mostly linked structures.
+//
+// Readers wrap every traversal in an EpochGuard. Writers unlink nodes and
+// hand them to retire() instead of deleting them; a retired node is freed
+// only after the global epoch has advanced twice, at which point no reader
+// that could still hold a pointer to it is active. There is one process-wide
+// domain so that each thread needs only a single reader record.
+class EpochDomain {
+public:
+    using Deleter = void (*)(void*);
+
+    static EpochDomain& global() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    ~EpochDomain() {
+        for (const Retired& r : retired) r.deleter(r.ptr);
+        Record* rec = records.load(std::memory_order_relaxed);
+        while (rec) {
+            Record* nxt = rec->next;
+            delete rec;
+            rec = nxt;
+        }
+    }
+
+    // Marks the calling thread as reading. Nested guards are allowed.
+    void enter() {
+        Record* rec = localRecord();
+        if (rec->nesting++ > 0) return;
+        uint64_t e = epoch.load(std::memory_order_relaxed);
+        rec->announce.store((e << 1) | 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void leave() {
+        Record* rec = localRecord();
+        if (--rec->nesting > 0) return;
+        rec->announce.store(0, std::memory_order_release);
+    }
+
+    // Queues ptr for deletion once every reader that might see it is gone.
+    // The caller must already have unlinked ptr from the shared structure.
+    void retire(void* ptr, Deleter deleter) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::lock_guard<std::mutex> lock(retireMutex);
+        retired.push_back({ptr, deleter, epoch.load(std::memory_order_relaxed)});
+        if (retired.size() >= kCollectThreshold) {
+            tryAdvance();
+            collect();
+        }
+    }
+
+    // Frees everything that can be freed right now. Returns the number of
+    // objects still waiting for readers to leave.
+    size_t reclaim() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::lock_guard<std::mutex> lock(retireMutex);
+        tryAdvance();
+        tryAdvance();
+        collect();
+        return retired.size();
+    }
+
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(retireMutex);
+        return retired.size();
+    }
+
+private:
+    static constexpr size_t kCollectThreshold = 64;
+
+    EpochDomain() = default;
+
+    struct alignas(64) Record {
+        // (epoch << 1) | 1 while the owning thread is inside a guard, 0 otherwise.
+        std::atomic<uint64_t> announce{0};
+        std::atomic<bool> inUse{true};
+        unsigned nesting = 0;
+        Record* next = nullptr;
+    };
+
+    struct Retired {
+        void* ptr;
+        Deleter deleter;
+        uint64_t epoch;
+    };
+
+    // Releases the thread's record when the thread exits so it can be reused.
+    struct LocalSlot {
+        Record* rec = nullptr;
+        ~LocalSlot() {
+            if (rec) {
+                rec->announce.store(0, std::memory_order_release);
+                rec->inUse.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    Record* localRecord() {
+        thread_local LocalSlot slot;
+        if (!slot.rec) slot.rec = acquireRecord();
+        return slot.rec;
+    }
+
+    Record* acquireRecord() {
+        for (Record* rec = records.load(std::memory_order_acquire); rec; rec = rec->next) {
+            bool expected = false;
+            if (!rec->inUse.load(std::memory_order_relaxed) &&
+                rec->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                rec->nesting = 0;
+                return rec;
+            }
+        }
+        Record* rec = new Record();
+        Record* head = records.load(std::memory_order_relaxed);
+        do {
+            rec->next = head;
+        } while (!records.compare_exchange_weak(head, rec, std::memory_order_release,
+                                                std::memory_order_relaxed));
+        return rec;
+    }
+
+    // Advances the global epoch if every active reader has observed it.
+    // Called with retireMutex held.
+    void tryAdvance() {
+        uint64_t e = epoch.load(std::memory_order_relaxed);
+        for (Record* rec = records.load(std::memory_order_acquire); rec; rec = rec->next) {
+            uint64_t a = rec->announce.load(std::memory_order_acquire);
+            if ((a & 1) && (a >> 1) != e) return;
+        }
+        epoch.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+    }
+
+    // Called with retireMutex held.
+    void collect() {
+        uint64_t e = epoch.load(std::memory_order_acquire);
+        size_t keep = 0;
+        for (size_t i = 0; i < retired.size(); ++i) {
+            if (retired[i].epoch + 2 <= e) {
+                retired[i].deleter(retired[i].ptr);
+            } else {
+                retired[keep++] = retired[i];
+            }
+        }
+        retired.resize(keep);
+    }
+
+    std::atomic<uint64_t> epoch{0};
+    std::atomic<Record*> records{nullptr};
+    mutable std::mutex retireMutex;
+    std::vector<Retired> retired;
+};
+
+class EpochGuard {
+public:
+    EpochGuard() : domain(&EpochDomain::global()) {
+        domain->enter();
+    }
+
+    EpochGuard(EpochGuard&& other) noexcept : domain(other.domain) {
+        other.domain = nullptr;
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+    EpochGuard& operator=(EpochGuard&&) = delete;
+
+    ~EpochGuard() {
+        if (domain) domain->leave();
+    }
+
+private:
+    EpochDomain* domain;
+};
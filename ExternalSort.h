@@ -0,0 +1,418 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "DoublyLinkedList.h"
+
+// External-memory merge sort for lists that do not fit in RAM.
+//
+// Values are buffered up to the memory budget, sorted, and spilled to a
+// temporary run file. finish_into() then merges the runs with a loser tree,
+// in several passes if there are more runs than the budget allows readers
+// for. All file I/O goes through buffers of io_buffer_bytes, so the disk
+// sees large sequential reads and writes.
+//
+// Run file format: a 16-byte header ("LLRUN1", uint16 sizeof(T), uint64
+// count, little-endian host layout) followed by the raw elements. T must be
+// trivially copyable; runs are scratch files and are not meant to be
+// portable between machines.
+
+struct ExternalSortOptions {
+    size_t memory_budget_bytes = size_t(64) << 20;
+    size_t io_buffer_bytes = size_t(1) << 20;
+    std::filesystem::path temp_dir;   // empty = std::filesystem::temp_directory_path()
+};
+
+template <typename T, typename Compare = std::less<T>>
+class ExternalSorter {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ExternalSorter spills raw bytes; T must be trivially copyable");
+
+    static constexpr char kMagic[6] = {'L', 'L', 'R', 'U', 'N', '1'};
+    static constexpr size_t kHeaderBytes = 16;
+
+    struct Run {
+        std::filesystem::path path;
+        uint64_t count;
+    };
+
+    class RunWriter {
+    public:
+        RunWriter(const std::filesystem::path& p, size_t bufferElems) : path(p) {
+            file = std::fopen(p.string().c_str(), "wb");
+            if (!file) throw std::runtime_error("ExternalSorter: cannot create " + p.string());
+            buffer.reserve(bufferElems);
+            writeHeader(0);
+        }
+
+        RunWriter(const RunWriter&) = delete;
+        RunWriter& operator=(const RunWriter&) = delete;
+
+        ~RunWriter() {
+            if (file) std::fclose(file);
+        }
+
+        void put(const T& value) {
+            buffer.push_back(value);
+            if (buffer.size() == buffer.capacity()) flush();
+        }
+
+        void put_all(const T* values, size_t n) {
+            flush();
+            writeRaw(values, n * sizeof(T));
+            count += n;
+        }
+
+        Run close() {
+            flush();
+            std::fseek(file, 0, SEEK_SET);
+            writeHeader(count);
+            if (std::fclose(file) != 0) {
+                file = nullptr;
+                throw std::runtime_error("ExternalSorter: write failed on " + path.string());
+            }
+            file = nullptr;
+            return Run{path, count};
+        }
+
+    private:
+        void writeHeader(uint64_t n) {
+            unsigned char header[kHeaderBytes] = {};
+            std::memcpy(header, kMagic, sizeof(kMagic));
+            uint16_t elem = static_cast<uint16_t>(sizeof(T));
+            std::memcpy(header + 6, &elem, sizeof(elem));
+            std::memcpy(header + 8, &n, sizeof(n));
+            writeRaw(header, kHeaderBytes);
+        }
+
+        void flush() {
+            if (buffer.empty()) return;
+            writeRaw(buffer.data(), buffer.size() * sizeof(T));
+            count += buffer.size();
+            buffer.clear();
+        }
+
+        void writeRaw(const void* data, size_t bytes) {
+            if (bytes && std::fwrite(data, 1, bytes, file) != bytes) {
+                throw std::runtime_error("ExternalSorter: write failed on " + path.string());
+            }
+        }
+
+        std::filesystem::path path;
+        std::FILE* file;
+        std::vector<T> buffer;
+        uint64_t count = 0;
+    };
+
+    class RunReader {
+    public:
+        RunReader(const Run& run, size_t bufferElems) : path(run.path), remaining(run.count) {
+            file = std::fopen(path.string().c_str(), "rb");
+            if (!file) throw std::runtime_error("ExternalSorter: cannot open " + path.string());
+            unsigned char header[kHeaderBytes];
+            uint16_t elem = 0;
+            uint64_t n = 0;
+            if (std::fread(header, 1, kHeaderBytes, file) != kHeaderBytes) fail();
+            std::memcpy(&elem, header + 6, sizeof(elem));
+            std::memcpy(&n, header + 8, sizeof(n));
+            if (std::memcmp(header, kMagic, sizeof(kMagic)) != 0 || elem != sizeof(T) || n != run.count) fail();
+            buffer.resize(std::max<size_t>(1, std::min<uint64_t>(bufferElems, remaining)));
+            refill();
+        }
+
+        RunReader(const RunReader&) = delete;
+        RunReader& operator=(const RunReader&) = delete;
+
+        RunReader(RunReader&& other) noexcept
+            : path(std::move(other.path)), file(std::exchange(other.file, nullptr)),
+              buffer(std::move(other.buffer)), pos(other.pos), filled(other.filled), remaining(other.remaining) {}
+
+        ~RunReader() {
+            if (file) std::fclose(file);
+        }
+
+        bool done() const { return pos == filled; }
+        const T& current() const { return buffer[pos]; }
+
+        void advance() {
+            if (++pos == filled) refill();
+        }
+
+    private:
+        void refill() {
+            pos = filled = 0;
+            if (remaining == 0) return;
+            size_t want = static_cast<size_t>(std::min<uint64_t>(buffer.size(), remaining));
+            if (std::fread(buffer.data(), sizeof(T), want, file) != want) fail();
+            filled = want;
+            remaining -= want;
+        }
+
+        [[noreturn]] void fail() {
+            std::fclose(file);
+            file = nullptr;
+            throw std::runtime_error("ExternalSorter: corrupt or truncated run " + path.string());
+        }
+
+        std::filesystem::path path;
+        std::FILE* file;
+        std::vector<T> buffer;
+        size_t pos = 0;
+        size_t filled = 0;
+        uint64_t remaining;
+    };
+
+    // Tournament tree over k readers. tree[0] holds the current winner and
+    // tree[1..k-1] the loser of each match, so advancing the winner replays
+    // only the log2(k) matches on its path to the root.
+    class LoserTree {
+    public:
+        LoserTree(std::vector<RunReader>& r, const Compare& c) : readers(r), comp(c), k(r.size()), tree(r.size()) {
+            if (k == 0) return;
+            std::vector<size_t> winners(2 * k);
+            for (size_t i = 0; i < k; ++i) winners[k + i] = i;
+            for (size_t node = k - 1; node >= 1; --node) {
+                size_t a = winners[2 * node];
+                size_t b = winners[2 * node + 1];
+                if (beats(a, b)) {
+                    winners[node] = a;
+                    tree[node] = b;
+                } else {
+                    winners[node] = b;
+                    tree[node] = a;
+                }
+            }
+            tree[0] = k == 1 ? 0 : winners[1];
+        }
+
+        bool done() const { return k == 0 || readers[tree[0]].done(); }
+        const T& top() const { return readers[tree[0]].current(); }
+
+        void pop() {
+            size_t winner = tree[0];
+            readers[winner].advance();
+            for (size_t node = (winner + k) / 2; node >= 1; node /= 2) {
+                if (beats(tree[node], winner)) std::swap(tree[node], winner);
+            }
+            tree[0] = winner;
+        }
+
+    private:
+        // Exhausted readers lose every match; ties go to the lower run index,
+        // which keeps the merge stable.
+        bool beats(size_t a, size_t b) const {
+            if (readers[a].done()) return false;
+            if (readers[b].done()) return true;
+            if (comp(readers[a].current(), readers[b].current())) return true;
+            if (comp(readers[b].current(), readers[a].current())) return false;
+            return a < b;
+        }
+
+        std::vector<RunReader>& readers;
+        const Compare& comp;
+        size_t k;
+        std::vector<size_t> tree;
+    };
+
+public:
+    explicit ExternalSorter(ExternalSortOptions options = ExternalSortOptions(), Compare c = Compare())
+        : opts(std::move(options)), comp(c) {
+        if (opts.temp_dir.empty()) opts.temp_dir = std::filesystem::temp_directory_path();
+        opts.io_buffer_bytes = std::max(opts.io_buffer_bytes, sizeof(T));
+        opts.memory_budget_bytes = std::max(opts.memory_budget_bytes, 3 * opts.io_buffer_bytes);
+        runCapacity = std::max<size_t>(1, opts.memory_budget_bytes / sizeof(T));
+        fanIn = std::max<size_t>(2, opts.memory_budget_bytes / opts.io_buffer_bytes - 1);
+        std::random_device rd;
+        tag = std::to_string(rd()) + "-" + std::to_string(reinterpret_cast<uintptr_t>(this));
+    }
+
+    ExternalSorter(const ExternalSorter&) = delete;
+    ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+    ~ExternalSorter() {
+        for (const Run& r : runs) removeQuietly(r.path);
+    }
+
+    // The run buffer grows geometrically up to the budget, so sorting a few
+    // values does not reserve the whole budget up front.
+    void add(const T& value) {
+        if (pending.size() == pending.capacity() && pending.capacity() < runCapacity) {
+            pending.reserve(std::min(runCapacity, std::max(ioElems(), 2 * pending.capacity())));
+        }
+        pending.push_back(value);
+        if (pending.size() == runCapacity) spill();
+    }
+
+    template <typename InputIt>
+    void add(InputIt first, InputIt last) {
+        for (; first != last; ++first) add(*first);
+    }
+
+    // Consumes the list front to back, freeing each node as it is buffered,
+    // so the list and the run buffer together never hold more than one
+    // budget's worth of extra memory.
+    void add(DoublyLinkedList<T>&& list) {
+        while (!list.empty()) {
+            add(list.front());
+            list.pop_front();
+        }
+    }
+
+    // Merges everything added so far, calling sink(const T&) in order. The
+    // sorter is empty afterwards and can be reused.
+    template <typename Sink>
+    void finish(Sink sink) {
+        if (runs.empty()) {
+            std::stable_sort(pending.begin(), pending.end(), comp);
+            for (const T& v : pending) sink(v);
+            pending.clear();
+            pending.shrink_to_fit();
+            return;
+        }
+        if (!pending.empty()) spill();
+        pending.shrink_to_fit();
+        while (runs.size() > fanIn) mergePass();
+        mergeRuns(runs.begin(), runs.end(), sink);
+        for (const Run& r : runs) removeQuietly(r.path);
+        runs.clear();
+    }
+
+    void finish_into(DoublyLinkedList<T>& out) {
+        finish([&](const T& v) { out.push_back(v); });
+    }
+
+    // Writes the sorted values as raw T records, in io_buffer_bytes blocks.
+    void finish_into(std::ostream& os) {
+        std::vector<T> block;
+        block.reserve(std::max<size_t>(1, opts.io_buffer_bytes / sizeof(T)));
+        auto flush = [&] {
+            os.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size() * sizeof(T)));
+            if (!os) throw std::runtime_error("ExternalSorter: output stream write failed");
+            block.clear();
+        };
+        finish([&](const T& v) {
+            block.push_back(v);
+            if (block.size() == block.capacity()) flush();
+        });
+        if (!block.empty()) flush();
+    }
+
+    size_t runs_spilled() const { return spilledRuns; }
+    size_t merge_passes() const { return passes; }
+    uint64_t bytes_written() const { return bytesWritten; }
+
+private:
+    std::filesystem::path nextRunPath() {
+        return opts.temp_dir / ("llsort-" + tag + "-" + std::to_string(runSerial++) + ".run");
+    }
+
+    size_t ioElems() const { return std::max<size_t>(1, opts.io_buffer_bytes / sizeof(T)); }
+
+    // A run file that fails part way is removed before the error propagates.
+    void spill() {
+        std::stable_sort(pending.begin(), pending.end(), comp);
+        std::filesystem::path out = nextRunPath();
+        try {
+            RunWriter w(out, 0);
+            // The whole sorted buffer goes out in one write.
+            w.put_all(pending.data(), pending.size());
+            runs.push_back(w.close());
+        } catch (...) {
+            removeQuietly(out);
+            throw;
+        }
+        bytesWritten += kHeaderBytes + pending.size() * sizeof(T);
+        ++spilledRuns;
+        pending.clear();
+    }
+
+    template <typename Sink>
+    void mergeRuns(typename std::vector<Run>::iterator first, typename std::vector<Run>::iterator last, Sink& sink) {
+        std::vector<RunReader> readers;
+        readers.reserve(static_cast<size_t>(last - first));
+        for (auto it = first; it != last; ++it) readers.emplace_back(*it, ioElems());
+        LoserTree tree(readers, comp);
+        while (!tree.done()) {
+            sink(tree.top());
+            tree.pop();
+        }
+    }
+
+    // Merges consecutive groups of fanIn runs into one run each; keeping
+    // groups consecutive keeps the overall sort stable. A group's inputs are
+    // removed only once its output is complete and recorded. If a merge
+    // throws, its half-written output is removed and runs is left listing
+    // every run file that still exists, merged or not, so nothing is lost
+    // and the destructor still cleans up.
+    void mergePass() {
+        std::vector<Run> next;
+        next.reserve(runs.size());
+        size_t i = 0;
+        std::filesystem::path out;
+        try {
+            for (; i < runs.size(); i += fanIn) {
+                auto first = runs.begin() + static_cast<std::ptrdiff_t>(i);
+                auto last = runs.begin() + static_cast<std::ptrdiff_t>(std::min(runs.size(), i + fanIn));
+                if (last - first == 1) {
+                    next.push_back(*first);
+                    continue;
+                }
+                out = nextRunPath();
+                RunWriter w(out, ioElems());
+                auto put = [&](const T& v) { w.put(v); };
+                mergeRuns(first, last, put);
+                next.push_back(w.close());
+                out.clear();
+                bytesWritten += kHeaderBytes + next.back().count * sizeof(T);
+                for (auto it = first; it != last; ++it) removeQuietly(it->path);
+            }
+        } catch (...) {
+            if (!out.empty()) removeQuietly(out);
+            next.insert(next.end(), runs.begin() + static_cast<std::ptrdiff_t>(i), runs.end());
+            runs.swap(next);
+            throw;
+        }
+        runs.swap(next);
+        ++passes;
+    }
+
+    static void removeQuietly(const std::filesystem::path& p) {
+        std::error_code ec;
+        std::filesystem::remove(p, ec);
+    }
+
+    ExternalSortOptions opts;
+    Compare comp;
+    size_t runCapacity;
+    size_t fanIn;
+    std::string tag;
+    size_t runSerial = 0;
+    std::vector<T> pending;
+    std::vector<Run> runs;
+    size_t spilledRuns = 0;
+    size_t passes = 0;
+    uint64_t bytesWritten = 0;
+};
+
+// Sorts list with at most options.memory_budget_bytes of working memory
+// beyond the list itself, draining it into runs and merging back.
+template <typename T, typename Compare = std::less<T>>
+void external_sort(DoublyLinkedList<T>& list, const ExternalSortOptions& options = ExternalSortOptions(),
+                   Compare comp = Compare()) {
+    ExternalSorter<T, Compare> sorter(options, comp);
+    sorter.add(std::move(list));
+    list.clear();
+    sorter.finish_into(list);
+}
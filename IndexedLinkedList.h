@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ListKernels.h"
+#include "ListMemory.h"
+#include "SlotListBase.h"
+
+// Doubly linked list for trivially copyable payloads, stored as a structure
+// of arrays: the values, next links and prev links live in three parallel
+// vectors and nodes refer to each other by 32-bit slot index. Erased slots
+// are threaded onto a free list and reused by later inserts. Linking, the
+// free list and the iterators are the slot list core in SlotListBase.h,
+// shared with CompactList.
+//
+// Because there are no raw pointers the whole list can be copied, moved or
+// written out with plain memcpy, and whole-list scans that do not care about
+// order (contains, count_occurrences, sum) run straight over the value array
+// whenever it has no holes.
+template <typename T>
+class IndexedLinkedList : public SlotListBase<IndexedLinkedList<T>, T, uint32_t> {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "IndexedLinkedList requires a trivially copyable element type");
+
+    using Base = SlotListBase<IndexedLinkedList<T>, T, uint32_t>;
+    friend Base;
+
+public:
+    using index_type = uint32_t;
+    using Base::npos;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+
+private:
+    using Base::head;
+    using Base::tail;
+    using Base::freeHead;
+    using Base::sz;
+
+    std::vector<T> values;
+    std::vector<index_type> nexts;
+    std::vector<index_type> prevs;
+    bool slotOrdered;   // slot i holds the i-th element (see in_slot_order())
+
+    T& valueOf(index_type slot) { return values[slot]; }
+    const T& valueOf(index_type slot) const { return values[slot]; }
+    index_type& nextOf(index_type slot) { return nexts[slot]; }
+    index_type nextOf(index_type slot) const { return nexts[slot]; }
+    index_type& prevOf(index_type slot) { return prevs[slot]; }
+    index_type prevOf(index_type slot) const { return prevs[slot]; }
+
+    index_type appendSlot(const T& value) {
+        if (values.size() >= npos) throw std::length_error("IndexedLinkedList: too many elements");
+        values.push_back(value);
+        nexts.push_back(npos);
+        prevs.push_back(npos);
+        return static_cast<index_type>(values.size() - 1);
+    }
+
+    void onLink(index_type pos, index_type slot) {
+        slotOrdered = slotOrdered && pos == npos && slot == sz;
+    }
+
+    void onUnlink() { slotOrdered = false; }
+
+    // No free slots: values[0, sz) holds exactly the live elements.
+    bool dense() const { return freeHead == npos; }
+
+public:
+    IndexedLinkedList() : slotOrdered(true) {}
+
+    IndexedLinkedList(std::initializer_list<T> init) : IndexedLinkedList() {
+        reserve(init.size());
+        for (const auto& val : init) this->push_back(val);
+    }
+
+    template <typename InputIt>
+    IndexedLinkedList(InputIt first, InputIt last) : IndexedLinkedList() {
+        for (; first != last; ++first) this->push_back(*first);
+    }
+
+    size_t capacity() const { return values.capacity(); }
+
+    // Footprint of the list (see ListMemory.h). Free-listed slots and spare
+    // capacity count as slack. O(1).
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m;
+        m.live_bytes = sz * sizeof(T);
+        m.overhead_bytes = sizeof(*this) + sz * 2 * sizeof(index_type);
+        m.slack_bytes = (values.size() - sz) * (sizeof(T) + 2 * sizeof(index_type));
+        list_memory::add_vector_buffer(m, values.size(), values.capacity(), sizeof(T));
+        list_memory::add_vector_buffer(m, nexts.size(), nexts.capacity(), sizeof(index_type));
+        list_memory::add_vector_buffer(m, prevs.size(), prevs.capacity(), sizeof(index_type));
+        return m;
+    }
+
+    void reserve(size_t n) {
+        values.reserve(n);
+        nexts.reserve(n);
+        prevs.reserve(n);
+    }
+
+    int remove_all(const T& value) {
+        int removed = 0;
+        index_type cur = head;
+        while (cur != npos) {
+            index_type nxt = nexts[cur];
+            if (values[cur] == value) {
+                this->unlink(cur);
+                ++removed;
+            }
+            cur = nxt;
+        }
+        return removed;
+    }
+
+    void clear() {
+        values.clear();
+        nexts.clear();
+        prevs.clear();
+        this->resetLinks();
+        slotOrdered = true;
+    }
+
+    // Swapping the link arrays turns every next into a prev, in O(1) for
+    // the live elements. The free list, threaded through nexts, is then
+    // walked to move it back, so the cost is O(free slots): O(1) on a list
+    // that has not erased since its last clear() or compact().
+    void reverse() {
+        slotOrdered = sz <= 1 && dense();
+        nexts.swap(prevs);
+        std::swap(head, tail);
+        // The free list is threaded through nexts; move it back.
+        for (index_type cur = freeHead; cur != npos;) {
+            index_type nxt = prevs[cur];
+            nexts[cur] = nxt;
+            prevs[cur] = npos;
+            cur = nxt;
+        }
+    }
+
+    // Rewrites the arrays so that slot i holds the i-th element and the free
+    // list is empty. Afterwards the value array is the list in order.
+    void compact() {
+        if (slotOrdered || (dense() && isInSlotOrder())) {
+            slotOrdered = true;
+            return;
+        }
+        std::vector<T> ordered;
+        ordered.reserve(sz);
+        for (index_type cur = head; cur != npos; cur = nexts[cur]) ordered.push_back(values[cur]);
+        values.swap(ordered);
+        nexts.resize(sz);
+        prevs.resize(sz);
+        for (size_t i = 0; i < sz; ++i) {
+            nexts[i] = (i + 1 < sz) ? static_cast<index_type>(i + 1) : npos;
+            prevs[i] = (i > 0) ? static_cast<index_type>(i - 1) : npos;
+        }
+        head = sz ? 0 : npos;
+        tail = sz ? static_cast<index_type>(sz - 1) : npos;
+        freeHead = npos;
+        slotOrdered = true;
+    }
+
+    // The raw value array. After compact() it is the list in order;
+    // otherwise it may contain stale values in free slots.
+    const T* data() const { return values.data(); }
+    size_t slot_count() const { return values.size(); }
+
+    // O(1) check that slot i holds the i-th element, so that position i can be
+    // reached directly. True after compact() or clear() and kept by
+    // push_back(); any other structural change resets it.
+    bool in_slot_order() const { return slotOrdered; }
+
+    // Queries. When there are no free slots these scan the value array
+    // directly, which the compiler can vectorize.
+    bool contains(const T& value) const {
+        if (dense()) {
+            for (size_t i = 0; i < sz; ++i) {
+                if (values[i] == value) return true;
+            }
+            return false;
+        }
+        for (index_type cur = head; cur != npos; cur = nexts[cur]) {
+            if (values[cur] == value) return true;
+        }
+        return false;
+    }
+
+    int count_occurrences(const T& value) const {
+        int count = 0;
+        if (dense()) {
+            for (size_t i = 0; i < sz; ++i) count += (values[i] == value);
+            return count;
+        }
+        for (index_type cur = head; cur != npos; cur = nexts[cur]) {
+            if (values[cur] == value) ++count;
+        }
+        return count;
+    }
+
+    T sum() const {
+        if (this->empty()) throw std::out_of_range("sum: list is empty");
+        T total = T();
+        if (dense()) {
+            for (size_t i = 0; i < sz; ++i) total += values[i];
+            return total;
+        }
+        for (index_type cur = head; cur != npos; cur = nexts[cur]) total += values[cur];
+        return total;
+    }
+
+    int find_first_index(const T& value) const {
+        int index = 0;
+        for (index_type cur = head; cur != npos; cur = nexts[cur], ++index) {
+            if (values[cur] == value) return index;
+        }
+        return -1;
+    }
+
+private:
+    bool isInSlotOrder() const {
+        if (sz == 0) return values.empty();
+        if (head != 0) return false;
+        for (size_t i = 0; i + 1 < sz; ++i) {
+            if (nexts[i] != i + 1) return false;
+        }
+        return true;
+    }
+};
+
+template <typename T>
+bool operator==(const IndexedLinkedList<T>& lhs, const IndexedLinkedList<T>& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    if constexpr (list_kernels::is_bitwise_comparable<T>::value) {
+        // Both value arrays are the lists in order: one memcmp.
+        if (lhs.in_slot_order() && rhs.in_slot_order()) {
+            return list_kernels::equal_contiguous(lhs.data(), rhs.data(), lhs.size());
+        }
+    }
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T>
+bool operator!=(const IndexedLinkedList<T>& lhs, const IndexedLinkedList<T>& rhs) {
+    return !(lhs == rhs);
+}
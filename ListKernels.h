@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Building blocks shared by the list comparison fast paths and the
+// incremental list hash.
+
+// LIST_CONSTEXPR marks the list operations that may run during constant
+// evaluation. From C++20 on (allocation, try blocks and
+// std::is_constant_evaluated in constexpr functions) it expands to
+// constexpr; under C++17 it expands to nothing and the lists are
+// unchanged.
+#if __cplusplus >= 202002L && defined(__cpp_constexpr_dynamic_alloc) && \
+    defined(__cpp_lib_is_constant_evaluated)
+#define LIST_CONSTEXPR constexpr
+#else
+#define LIST_CONSTEXPR
+#endif
+
+namespace list_kernels {
+
+// True while the caller is being evaluated at compile time; always false
+// before C++20. Guards the side effects (stats export) that cannot happen
+// there.
+constexpr bool in_constant_evaluation() {
+#ifdef __cpp_lib_is_constant_evaluated
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// Types whose operator== is plain bit equality and whose comparisons cannot
+// throw: integers, enums and pointers. Floating point is excluded (NaN,
+// -0.0), as is anything with padding or a user-defined operator==. The list
+// kernels use the unrolled, memcmp-able paths only for these.
+template <typename T>
+struct is_bitwise_comparable
+    : std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value ||
+                                       std::is_pointer<T>::value> {};
+
+// Equality of two contiguous runs of bitwise comparable values.
+template <typename T>
+inline bool equal_contiguous(const T* a, const T* b, size_t n) {
+    static_assert(is_bitwise_comparable<T>::value, "equal_contiguous needs a bitwise comparable T");
+    return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+}
+
+template <typename T, typename = void>
+struct is_std_hashable : std::false_type {};
+
+template <typename T>
+struct is_std_hashable<T, decltype(void(std::hash<T>()(std::declval<const T&>())))> : std::true_type {};
+
+// Spreads an element hash over all 64 bits (splitmix64 finalizer), so that
+// std::hash implementations that return the value itself still make good
+// hash terms.
+constexpr uint64_t mix_hash(uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+// Odd multiplier for the order-sensitive polynomial list hash:
+// H(x0..xn-1) = sum mix(xi) * kHashBase^(n-1-i)  (mod 2^64).
+constexpr uint64_t kHashBase = 0x9e3779b97f4a7c15ull;
+
+// Inverse of an odd number modulo 2^64 (Newton's iteration; each step
+// doubles the number of correct low bits).
+constexpr uint64_t inverse_odd(uint64_t a) {
+    uint64_t x = a;   // correct to 3 bits for odd a
+    for (int i = 0; i < 5; ++i) x *= 2 - a * x;
+    return x;
+}
+
+// Polynomial hash of a sequence kept in a form that can be concatenated and
+// split in O(1):
+//   fwd = sum h_i B^(n-1-i)   (the list hash)
+//   bwd = sum h_i B^i         (the hash of the reversed sequence)
+//   pow = B^n
+// B is odd, so pow is invertible and a known prefix or suffix can be
+// stripped off again.
+struct SeqHash {
+    uint64_t fwd = 0;
+    uint64_t bwd = 0;
+    uint64_t pow = 1;
+
+    static constexpr SeqHash of(uint64_t h) { return SeqHash{h, h, kHashBase}; }
+
+    constexpr SeqHash reversed() const { return SeqHash{bwd, fwd, pow}; }
+};
+
+constexpr SeqHash concat(const SeqHash& x, const SeqHash& y) {
+    return SeqHash{x.fwd * y.pow + y.fwd, x.bwd + x.pow * y.bwd, x.pow * y.pow};
+}
+
+// w = x ++ y; returns y.
+constexpr SeqHash strip_prefix(const SeqHash& w, const SeqHash& x) {
+    uint64_t inv = inverse_odd(x.pow);
+    uint64_t ypow = w.pow * inv;
+    return SeqHash{w.fwd - x.fwd * ypow, (w.bwd - x.bwd) * inv, ypow};
+}
+
+// w = x ++ y; returns x.
+constexpr SeqHash strip_suffix(const SeqHash& w, const SeqHash& y) {
+    uint64_t inv = inverse_odd(y.pow);
+    uint64_t xpow = w.pow * inv;
+    return SeqHash{(w.fwd - y.fwd) * inv, w.bwd - xpow * y.bwd, xpow};
+}
+
+} // namespace list_kernels
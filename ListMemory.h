@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+
+// Memory footprint reporting shared by the list containers' memory_usage().
+//
+//   live      bytes holding element values (sizeof(T) per element; memory
+//             the elements own themselves, e.g. a string's buffer, is not
+//             followed)
+//   slack     bytes allocated but holding nothing: spare vector capacity,
+//             free-listed nodes and slots, unused arena tails, and the
+//             padding the heap adds when it rounds a request up
+//   overhead  bytes spent on structure: links, towers, in-node padding,
+//             per-allocation heap headers and the container object itself
+//
+// Heap rounding and headers are estimated with the usual 64-bit malloc
+// layout (one size_t header per block, 16-byte granularity, 32-byte minimum
+// block), so totals track what the process actually pays rather than what
+// sizeof reports.
+struct ListMemoryUsage {
+    size_t live_bytes = 0;
+    size_t slack_bytes = 0;
+    size_t overhead_bytes = 0;
+
+    size_t total_bytes() const { return live_bytes + slack_bytes + overhead_bytes; }
+
+    // Share of the footprint that holds elements, in [0, 1].
+    double efficiency() const {
+        size_t total = total_bytes();
+        return total ? static_cast<double>(live_bytes) / total : 1.0;
+    }
+
+    ListMemoryUsage& operator+=(const ListMemoryUsage& other) {
+        live_bytes += other.live_bytes;
+        slack_bytes += other.slack_bytes;
+        overhead_bytes += other.overhead_bytes;
+        return *this;
+    }
+};
+
+inline void write_json(std::ostream& os, const ListMemoryUsage& m) {
+    os << "{\"live_bytes\": " << m.live_bytes
+       << ", \"slack_bytes\": " << m.slack_bytes
+       << ", \"overhead_bytes\": " << m.overhead_bytes
+       << ", \"total_bytes\": " << m.total_bytes() << "}";
+}
+
+namespace list_memory {
+
+constexpr size_t kHeapHeaderBytes = sizeof(size_t);
+constexpr size_t kHeapGranule = 2 * sizeof(size_t);
+constexpr size_t kHeapMinBlock = 4 * sizeof(size_t);
+
+// Bytes the heap sets aside for a request of n bytes, header included.
+constexpr size_t heap_block_bytes(size_t n) {
+    size_t block = (n + kHeapHeaderBytes + kHeapGranule - 1) / kHeapGranule * kHeapGranule;
+    return block < kHeapMinBlock ? kHeapMinBlock : block;
+}
+
+// Adds one heap allocation of `requested` bytes: its header to overhead and
+// its rounding to slack. The requested bytes themselves are classified by
+// the caller.
+inline void add_heap_block(ListMemoryUsage& m, size_t requested) {
+    if (requested == 0) return;
+    m.overhead_bytes += kHeapHeaderBytes;
+    m.slack_bytes += heap_block_bytes(requested) - requested - kHeapHeaderBytes;
+}
+
+// count separately allocated nodes of node_bytes each, every one holding a
+// payload of payload_bytes; the rest of the node is overhead.
+inline void add_nodes(ListMemoryUsage& m, size_t count, size_t node_bytes, size_t payload_bytes) {
+    m.live_bytes += count * payload_bytes;
+    m.overhead_bytes += count * (node_bytes - payload_bytes + kHeapHeaderBytes);
+    m.slack_bytes += count * (heap_block_bytes(node_bytes) - node_bytes - kHeapHeaderBytes);
+}
+
+// A std::vector buffer whose first `used` of `capacity` elements of
+// elem_bytes each are accounted for by the caller; the unused tail is slack.
+inline void add_vector_buffer(ListMemoryUsage& m, size_t used, size_t capacity, size_t elem_bytes) {
+    m.slack_bytes += (capacity - std::min(used, capacity)) * elem_bytes;
+    add_heap_block(m, capacity * elem_bytes);
+}
+
+} // namespace list_memory
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+
+// Opt-in instrumentation for the list containers.
+//
+// Define LINKED_LIST_ENABLE_STATS before including a list header (or pass
+// -DLINKED_LIST_ENABLE_STATS) to compile the counters in. Without it
+// LIST_STAT() expands to nothing and the lists carry no extra members.
+
+#ifdef LINKED_LIST_ENABLE_STATS
+#ifdef __cpp_lib_is_constant_evaluated
+// Counting is skipped while a list is used in constant evaluation.
+#define LIST_STAT(stmt) do { if (!std::is_constant_evaluated()) { stmt; } } while (0)
+#else
+#define LIST_STAT(stmt) do { stmt; } while (0)
+#endif
+#else
+#define LIST_STAT(stmt) do { } while (0)
+#endif
+
+struct ListStats {
+    uint64_t node_allocations = 0;
+    uint64_t node_frees = 0;
+    uint64_t indexed_lookups = 0;     // getNodeAt() calls
+    uint64_t indexed_walk_steps = 0;  // links followed inside getNodeAt()
+    uint64_t longest_indexed_walk = 0;
+    uint64_t traversal_steps = 0;     // links followed by searches and bulk operations
+    uint64_t splice_calls = 0;
+    uint64_t merge_calls = 0;
+    size_t peak_size = 0;
+
+    // Average links walked per indexed access; a value that grows with the
+    // list size means operator[] / at() is being used in a loop.
+    double mean_indexed_walk() const {
+        return indexed_lookups ? static_cast<double>(indexed_walk_steps) / indexed_lookups : 0.0;
+    }
+};
+
+inline void write_json(std::ostream& os, const ListStats& s) {
+    os << "{\"node_allocations\": " << s.node_allocations
+       << ", \"node_frees\": " << s.node_frees
+       << ", \"indexed_lookups\": " << s.indexed_lookups
+       << ", \"indexed_walk_steps\": " << s.indexed_walk_steps
+       << ", \"longest_indexed_walk\": " << s.longest_indexed_walk
+       << ", \"traversal_steps\": " << s.traversal_steps
+       << ", \"splice_calls\": " << s.splice_calls
+       << ", \"merge_calls\": " << s.merge_calls
+       << ", \"peak_size\": " << s.peak_size << "}";
+}
+
+// Process-wide export hook. When set, each instrumented list hands its final
+// counters to the hook as it is destroyed; lists can also push a snapshot
+// explicitly with export_stats().
+using ListStatsExporter = void (*)(const char* label, const ListStats& stats);
+
+inline ListStatsExporter& list_stats_exporter() {
+    static ListStatsExporter exporter = nullptr;
+    return exporter;
+}
+
+inline void set_list_stats_exporter(ListStatsExporter exporter) {
+    list_stats_exporter() = exporter;
+}
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "DoublyLinkedList.h"
+#include "IndexedLinkedList.h"
+
+// Parallel for_each / reduce / transform / filter over list containers.
+//
+// Each call cuts the list into balanced segments (one O(n) walk; O(p) for an
+// IndexedLinkedList that is in slot order), then runs one task per segment
+// on a work-stealing pool. There are several segments per worker so that a
+// worker that finishes early can steal from a slower one. Inputs shorter
+// than ParallelOptions::sequential_cutoff are processed inline.
+//
+// Works with any container that has begin(), end() and size():
+// DoublyLinkedList, IndexedLinkedList, std::list, ...
+
+// Fixed set of workers, each with its own task deque. A worker pops from
+// the back of its own deque and steals from the front of the others'. The
+// thread that submits a batch also runs tasks until the batch is done, so
+// nested parallel calls cannot deadlock the pool.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threads = std::thread::hardware_concurrency())
+        : queues(std::max(1u, threads)) {
+        workers.reserve(queues.size());
+        for (size_t i = 0; i < queues.size(); ++i) workers.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        sleepCv.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    // Process-wide pool sized to the hardware, created on first use.
+    static WorkStealingPool& shared() {
+        static WorkStealingPool pool;
+        return pool;
+    }
+
+    size_t worker_count() const { return workers.size(); }
+
+    // Runs every task and returns once all have finished. The first
+    // exception thrown by a task is rethrown here.
+    void run_all(std::vector<std::function<void()>>& tasks) {
+        if (tasks.empty()) return;
+        Batch batch;
+        batch.remaining.store(tasks.size(), std::memory_order_relaxed);
+        std::vector<Task> slots(tasks.size());
+        // Counted before the tasks are published, so that a worker popping
+        // one right away never takes queued below zero. queued may briefly
+        // exceed the tasks in the deques, which only costs a worker a retry.
+        queued.fetch_add(tasks.size(), std::memory_order_release);
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            slots[i].fn = &tasks[i];
+            slots[i].batch = &batch;
+            Queue& q = queues[i % queues.size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(&slots[i]);
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        sleepCv.notify_all();
+
+        size_t victim = 0;
+        while (batch.remaining.load(std::memory_order_acquire) != 0) {
+            if (Task* t = steal(victim++)) run(t);
+            else std::this_thread::yield();
+        }
+        if (batch.error) std::rethrow_exception(batch.error);
+    }
+
+private:
+    struct Batch {
+        std::atomic<size_t> remaining{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    struct Task {
+        std::function<void()>* fn = nullptr;
+        Batch* batch = nullptr;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task*> tasks;
+    };
+
+    Task* popOwn(size_t self) {
+        Queue& q = queues[self];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) return nullptr;
+        Task* t = q.tasks.back();
+        q.tasks.pop_back();
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return t;
+    }
+
+    // Tries every queue once, starting at start.
+    Task* steal(size_t start) {
+        for (size_t i = 0; i < queues.size(); ++i) {
+            Queue& q = queues[(start + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) continue;
+            Task* t = q.tasks.front();
+            q.tasks.pop_front();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return t;
+        }
+        return nullptr;
+    }
+
+    static void run(Task* t) {
+        Batch* batch = t->batch;
+        try {
+            (*t->fn)();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(batch->errorMutex);
+            if (!batch->error) batch->error = std::current_exception();
+        }
+        batch->remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void workerLoop(size_t self) {
+        for (;;) {
+            Task* t = popOwn(self);
+            if (!t) t = steal(self + 1);
+            if (t) {
+                run(t);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepCv.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) != 0; });
+            if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+
+    std::deque<Queue> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::mutex sleepMutex;
+    std::condition_variable sleepCv;
+    bool stopping = false;
+};
+
+struct ParallelOptions {
+    size_t sequential_cutoff = 16384;   // below this many elements, run inline
+    size_t segments_per_worker = 4;
+    WorkStealingPool* pool = nullptr;  // nullptr = WorkStealingPool::shared()
+};
+
+namespace parallel_detail {
+
+template <typename Container>
+auto walkSegments(Container& c, size_t parts) -> std::vector<decltype(c.begin())> {
+    using It = decltype(c.begin());
+    size_t n = c.size();
+    parts = std::max<size_t>(1, std::min(parts, n));
+    std::vector<It> bounds;
+    bounds.reserve(parts + 1);
+    It it = c.begin();
+    bounds.push_back(it);
+    for (size_t p = 0; p < parts; ++p) {
+        size_t len = n / parts + (p < n % parts ? 1 : 0);
+        for (size_t i = 0; i < len; ++i) ++it;
+        bounds.push_back(it);
+    }
+    return bounds;
+}
+
+// In slot order the i-th element is slot i, so each cut is O(1).
+template <typename List>
+auto indexedSegments(List& c, size_t parts) -> std::vector<decltype(c.begin())> {
+    using It = decltype(c.begin());
+    if (!c.in_slot_order()) return walkSegments(c, parts);
+    size_t n = c.size();
+    parts = std::max<size_t>(1, std::min(parts, n));
+    std::vector<It> bounds;
+    bounds.reserve(parts + 1);
+    for (size_t p = 0; p <= parts; ++p) {
+        size_t start = p * (n / parts) + std::min(p, n % parts);
+        bounds.push_back(start == n ? c.end() : It(&c, static_cast<uint32_t>(start)));
+    }
+    return bounds;
+}
+
+} // namespace parallel_detail
+
+// parts + 1 iterators cutting the container into parts runs whose lengths
+// differ by at most one. One walk over the list.
+template <typename Container>
+auto list_segments(Container& c, size_t parts) -> std::vector<decltype(c.begin())> {
+    return parallel_detail::walkSegments(c, parts);
+}
+
+template <typename T>
+std::vector<typename IndexedLinkedList<T>::iterator> list_segments(IndexedLinkedList<T>& c, size_t parts) {
+    return parallel_detail::indexedSegments(c, parts);
+}
+
+template <typename T>
+std::vector<typename IndexedLinkedList<T>::const_iterator> list_segments(const IndexedLinkedList<T>& c, size_t parts) {
+    return parallel_detail::indexedSegments(c, parts);
+}
+
+namespace parallel_detail {
+
+// Segments per call. The submitting thread works alongside the pool, so it
+// counts as one more worker.
+inline size_t maxSegments(const ParallelOptions& opts) {
+    WorkStealingPool& pool = opts.pool ? *opts.pool : WorkStealingPool::shared();
+    return (pool.worker_count() + 1) * std::max<size_t>(1, opts.segments_per_worker);
+}
+
+// Calls body(segment_index, first, last) for each segment, in parallel when
+// the input is large enough. Returns the number of segments used.
+template <typename Container, typename Body>
+size_t forEachSegment(Container& c, const ParallelOptions& opts, Body body) {
+    WorkStealingPool& pool = opts.pool ? *opts.pool : WorkStealingPool::shared();
+    size_t n = c.size();
+    if (n < std::max<size_t>(1, opts.sequential_cutoff)) {
+        body(size_t(0), c.begin(), c.end());
+        return 1;
+    }
+    auto bounds = list_segments(c, maxSegments(opts));
+    size_t parts = bounds.size() - 1;
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(parts);
+    for (size_t p = 0; p < parts; ++p) {
+        tasks.emplace_back([&body, &bounds, p] { body(p, bounds[p], bounds[p + 1]); });
+    }
+    pool.run_all(tasks);
+    return parts;
+}
+
+struct Identity {
+    template <typename U>
+    U&& operator()(U&& v) const { return std::forward<U>(v); }
+};
+
+} // namespace parallel_detail
+
+// f(element&) on every element. Segments run concurrently, so f must not
+// touch shared state without synchronization.
+template <typename Container, typename F>
+void parallel_for_each(Container& c, F f, const ParallelOptions& opts = ParallelOptions()) {
+    parallel_detail::forEachSegment(c, opts, [&f](size_t, auto first, auto last) {
+        for (; first != last; ++first) f(*first);
+    });
+}
+
+// op(...op(op(init, map(e0)), map(e1))..., map(en-1)). op must be
+// associative; it need not be commutative, segments are combined in order.
+template <typename Container, typename R, typename BinaryOp, typename Map = parallel_detail::Identity>
+R parallel_reduce(const Container& c, R init, BinaryOp op, Map map = Map(), const ParallelOptions& opts = ParallelOptions()) {
+    std::vector<R> partial;
+    std::vector<char> present(parallel_detail::maxSegments(opts), 0);
+    partial.resize(present.size(), init);
+    size_t parts = parallel_detail::forEachSegment(c, opts, [&](size_t p, auto first, auto last) {
+        if (first == last) return;
+        R acc = map(*first);
+        for (++first; first != last; ++first) acc = op(std::move(acc), map(*first));
+        partial[p] = std::move(acc);
+        present[p] = 1;
+    });
+    R result = std::move(init);
+    for (size_t p = 0; p < parts; ++p) {
+        if (present[p]) result = op(std::move(result), std::move(partial[p]));
+    }
+    return result;
+}
+
+// New list of f(element), in order. Each segment fills its own list and the
+// pieces are spliced together in O(segments).
+template <typename Container, typename F>
+auto parallel_transform(const Container& c, F f, const ParallelOptions& opts = ParallelOptions())
+    -> DoublyLinkedList<typename std::decay<decltype(f(*c.begin()))>::type> {
+    using U = typename std::decay<decltype(f(*c.begin()))>::type;
+    std::vector<DoublyLinkedList<U>> pieces(parallel_detail::maxSegments(opts));
+    size_t parts = parallel_detail::forEachSegment(c, opts, [&](size_t p, auto first, auto last) {
+        for (; first != last; ++first) pieces[p].push_back(f(*first));
+    });
+    DoublyLinkedList<U> out;
+    for (size_t p = 0; p < parts; ++p) out.splice(out.end(), pieces[p]);
+    return out;
+}
+
+// New list of the elements satisfying pred, in their original order.
+template <typename Container, typename Pred>
+auto parallel_filter(const Container& c, Pred pred, const ParallelOptions& opts = ParallelOptions())
+    -> DoublyLinkedList<typename std::decay<decltype(*c.begin())>::type> {
+    using U = typename std::decay<decltype(*c.begin())>::type;
+    std::vector<DoublyLinkedList<U>> pieces(parallel_detail::maxSegments(opts));
+    size_t parts = parallel_detail::forEachSegment(c, opts, [&](size_t p, auto first, auto last) {
+        for (; first != last; ++first) {
+            if (pred(*first)) pieces[p].push_back(*first);
+        }
+    });
+    DoublyLinkedList<U> out;
+    for (size_t p = 0; p < parts; ++p) out.splice(out.end(), pieces[p]);
+    return out;
+}
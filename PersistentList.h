@@ -0,0 +1,305 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "DoublyLinkedList.h"
+#include "ListMemory.h"
+
+// Immutable singly linked list with structurally shared, reference-counted
+// nodes. A PersistentList value is a cheap handle: copying it (or calling
+// snapshot()) only bumps the head's reference count, and push_front /
+// pop_front build a new version in O(1) without disturbing any other handle
+// that shares the same tail. Handles may be read from several threads.
+//
+// For bulk construction use Transient, which appends to nodes it owns
+// exclusively and then freezes them into a PersistentList.
+template <typename T>
+class PersistentList {
+private:
+    struct Node {
+        T data;
+        Node* next;
+        mutable std::atomic<size_t> refs;
+
+        Node(const T& value, Node* nxt) : data(value), next(nxt), refs(1) {}
+        Node(T&& value, Node* nxt) : data(std::move(value)), next(nxt), refs(1) {}
+    };
+
+    Node* head;
+    size_t sz;
+
+    static Node* retain(Node* node) {
+        if (node) node->refs.fetch_add(1, std::memory_order_relaxed);
+        return node;
+    }
+
+    // Iterative so that dropping the last handle to a long list cannot
+    // overflow the stack.
+    static void release(Node* node) {
+        while (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Node* nxt = node->next;
+            delete node;
+            node = nxt;
+        }
+    }
+
+    PersistentList(Node* h, size_t n) : head(h), sz(n) {}
+
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator(const Node* node) : current(node) {}
+
+        reference operator*() const { return current->data; }
+        pointer operator->() const { return &(current->data); }
+
+        const_iterator& operator++() {
+            current = current->next;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const { return current == other.current; }
+        bool operator!=(const const_iterator& other) const { return current != other.current; }
+
+    private:
+        const Node* current;
+    };
+
+    using iterator = const_iterator;
+
+    class Transient;
+
+    PersistentList() : head(nullptr), sz(0) {}
+
+    PersistentList(std::initializer_list<T> init) : PersistentList() {
+        Transient builder;
+        for (const auto& val : init) builder.push_back(val);
+        *this = builder.persistent();
+    }
+
+    explicit PersistentList(const DoublyLinkedList<T>& list) : PersistentList() {
+        Transient builder;
+        for (const auto& val : list) builder.push_back(val);
+        *this = builder.persistent();
+    }
+
+    PersistentList(const PersistentList& other) : head(retain(other.head)), sz(other.sz) {}
+
+    PersistentList(PersistentList&& other) noexcept : head(other.head), sz(other.sz) {
+        other.head = nullptr;
+        other.sz = 0;
+    }
+
+    PersistentList& operator=(const PersistentList& other) {
+        if (this != &other) {
+            Node* old = head;
+            head = retain(other.head);
+            sz = other.sz;
+            release(old);
+        }
+        return *this;
+    }
+
+    PersistentList& operator=(PersistentList&& other) noexcept {
+        if (this != &other) {
+            release(head);
+            head = other.head;
+            sz = other.sz;
+            other.head = nullptr;
+            other.sz = 0;
+        }
+        return *this;
+    }
+
+    ~PersistentList() {
+        release(head);
+    }
+
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(nullptr); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    bool empty() const { return head == nullptr; }
+    size_t size() const { return sz; }
+
+    // Footprint of this version (see ListMemory.h). Nodes shared with other
+    // versions are counted here too, so summing over versions overstates
+    // the total.
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m;
+        list_memory::add_nodes(m, sz, sizeof(Node), sizeof(T));
+        m.overhead_bytes += sizeof(*this);
+        return m;
+    }
+
+    const T& front() const {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return head->data;
+    }
+
+    // O(1): a new handle sharing this version's nodes.
+    PersistentList snapshot() const { return *this; }
+
+    void push_front(const T& value) {
+        head = new Node(value, head);
+        ++sz;
+    }
+
+    void push_front(T&& value) {
+        head = new Node(std::move(value), head);
+        ++sz;
+    }
+
+    bool pop_front() {
+        if (empty()) return false;
+        Node* old = head;
+        head = retain(old->next);
+        --sz;
+        release(old);
+        return true;
+    }
+
+    // Persistent-style variants that leave *this untouched.
+    PersistentList with_front(const T& value) const {
+        return PersistentList(new Node(value, retain(head)), sz + 1);
+    }
+
+    PersistentList without_front() const {
+        if (empty()) throw std::out_of_range("without_front: list is empty");
+        return PersistentList(retain(head->next), sz - 1);
+    }
+
+    void clear() {
+        release(head);
+        head = nullptr;
+        sz = 0;
+    }
+
+    // True when both handles refer to the same version.
+    bool shares_with(const PersistentList& other) const {
+        return head == other.head;
+    }
+
+    Transient transient() const {
+        Transient builder;
+        for (const auto& val : *this) builder.push_back(val);
+        return builder;
+    }
+
+    DoublyLinkedList<T> to_doubly_linked_list() const {
+        DoublyLinkedList<T> list;
+        for (const auto& val : *this) list.push_back(val);
+        return list;
+    }
+};
+
+// Batch-mutable builder. Its nodes are not shared with anyone until
+// persistent() is called, so push_back can link in place in O(1).
+template <typename T>
+class PersistentList<T>::Transient {
+public:
+    Transient() : head(nullptr), tail(nullptr), sz(0) {}
+
+    Transient(const Transient&) = delete;
+    Transient& operator=(const Transient&) = delete;
+
+    Transient(Transient&& other) noexcept : head(other.head), tail(other.tail), sz(other.sz) {
+        other.head = other.tail = nullptr;
+        other.sz = 0;
+    }
+
+    Transient& operator=(Transient&& other) noexcept {
+        if (this != &other) {
+            PersistentList::release(head);
+            head = other.head;
+            tail = other.tail;
+            sz = other.sz;
+            other.head = other.tail = nullptr;
+            other.sz = 0;
+        }
+        return *this;
+    }
+
+    ~Transient() {
+        PersistentList::release(head);
+    }
+
+    bool empty() const { return head == nullptr; }
+    size_t size() const { return sz; }
+
+    void push_front(const T& value) {
+        head = new Node(value, head);
+        if (!tail) tail = head;
+        ++sz;
+    }
+
+    void push_back(const T& value) {
+        Node* node = new Node(value, nullptr);
+        if (tail) tail->next = node;
+        else head = node;
+        tail = node;
+        ++sz;
+    }
+
+    void push_back(T&& value) {
+        Node* node = new Node(std::move(value), nullptr);
+        if (tail) tail->next = node;
+        else head = node;
+        tail = node;
+        ++sz;
+    }
+
+    bool pop_front() {
+        if (empty()) return false;
+        Node* old = head;
+        head = head->next;
+        if (!head) tail = nullptr;
+        old->next = nullptr;
+        PersistentList::release(old);
+        --sz;
+        return true;
+    }
+
+    // Freezes the builder; it is left empty.
+    PersistentList persistent() {
+        PersistentList result(head, sz);
+        head = tail = nullptr;
+        sz = 0;
+        return result;
+    }
+
+private:
+    Node* head;
+    Node* tail;
+    size_t sz;
+};
+
+template <typename T>
+bool operator==(const PersistentList<T>& lhs, const PersistentList<T>& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    if (lhs.shares_with(rhs)) return true;
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T>
+bool operator!=(const PersistentList<T>& lhs, const PersistentList<T>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,513 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ListMemory.h"
+
+// Ordered key/value container built as a skip list over a doubly linked
+// bottom level. Iterators walk the bottom prev/next chain exactly like
+// DoublyLinkedList's, so forward and backward range scans are plain
+// pointer chasing; the express lanes above it give O(log n) expected
+// insert, lookup and erase.
+//
+// Concurrency: find(), iteration and concurrent_insert() may run at the
+// same time from any number of threads (optimistic lazy insertion: search
+// without locks, lock the predecessors, validate, link bottom-up). insert(),
+// erase() and clear() require exclusive access.
+//
+// Nodes and their towers are carved from a per-height pool, so a node and
+// all of its forward links share one allocation and erased nodes are reused.
+template <typename K, typename V, typename Compare = std::less<K>>
+class SkipList {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+
+    static constexpr int kMaxLevel = 24;
+
+private:
+    class SpinLock {
+    public:
+        void lock() {
+            while (flag.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+        }
+        void unlock() { flag.clear(std::memory_order_release); }
+
+    private:
+        std::atomic_flag flag = ATOMIC_FLAG_INIT;
+    };
+
+    struct NodeBase {
+        std::atomic<NodeBase*>* next;   // `height` forward links
+        std::atomic<NodeBase*> prev;    // bottom level; the head for the first node
+        int height;
+        std::atomic<bool> fullyLinked;
+        SpinLock lock;
+
+        NodeBase(std::atomic<NodeBase*>* tower, int h)
+            : next(tower), prev(nullptr), height(h), fullyLinked(false) {
+            for (int l = 0; l < h; ++l) new (&next[l]) std::atomic<NodeBase*>(nullptr);
+        }
+    };
+
+    struct Node : NodeBase {
+        value_type kv;
+
+        template <typename KK, typename... Args>
+        Node(std::atomic<NodeBase*>* tower, int h, KK&& key, Args&&... args)
+            : NodeBase(tower, h),
+              kv(std::piecewise_construct, std::forward_as_tuple(std::forward<KK>(key)),
+                 std::forward_as_tuple(std::forward<Args>(args)...)) {}
+    };
+
+    // One size class per tower height. A block holds the Node followed by
+    // its tower; blocks are cut from 64 KiB slabs and recycled on erase.
+    class NodePool {
+    public:
+        NodePool() {
+            for (int h = 0; h <= kMaxLevel; ++h) freeLists[h] = nullptr;
+        }
+
+        NodePool(const NodePool&) = delete;
+        NodePool& operator=(const NodePool&) = delete;
+
+        ~NodePool() {
+            for (char* slab : slabs) ::operator delete(slab);
+        }
+
+        static constexpr size_t towerOffset() {
+            return (sizeof(Node) + alignof(std::atomic<NodeBase*>) - 1) / alignof(std::atomic<NodeBase*>) *
+                   alignof(std::atomic<NodeBase*>);
+        }
+
+        static constexpr size_t blockSize(int height) {
+            size_t raw = towerOffset() + height * sizeof(std::atomic<NodeBase*>);
+            return (raw + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+        }
+
+        void* allocate(int height) {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (FreeBlock* block = freeLists[height]) {
+                freeLists[height] = block->next;
+                return block;
+            }
+            size_t bytes = blockSize(height);
+            if (bytes > kSlabBytes) {
+                char* big = static_cast<char*>(::operator new(bytes));
+                slabs.push_back(big);
+                reservedBytes += bytes;
+                return big;
+            }
+            if (slabLeft < bytes) {
+                slabCursor = static_cast<char*>(::operator new(kSlabBytes));
+                slabs.push_back(slabCursor);
+                slabLeft = kSlabBytes;
+                reservedBytes += kSlabBytes;
+            }
+            void* mem = slabCursor;
+            slabCursor += bytes;
+            slabLeft -= bytes;
+            return mem;
+        }
+
+        void release(void* mem, int height) {
+            std::lock_guard<std::mutex> guard(mutex);
+            FreeBlock* block = static_cast<FreeBlock*>(mem);
+            block->next = freeLists[height];
+            freeLists[height] = block;
+        }
+
+        // Bytes obtained from the heap, and in how many allocations.
+        size_t reserved_bytes() const { return reservedBytes; }
+        size_t allocation_count() const { return slabs.size(); }
+
+    private:
+        static constexpr size_t kSlabBytes = 64 * 1024;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        std::mutex mutex;
+        FreeBlock* freeLists[kMaxLevel + 1];
+        std::vector<char*> slabs;
+        char* slabCursor = nullptr;
+        size_t slabLeft = 0;
+        size_t reservedBytes = 0;
+    };
+
+    std::atomic<NodeBase*> headTower[kMaxLevel];
+    NodeBase head;
+    std::atomic<NodeBase*> tail;
+    std::atomic<size_t> sz;
+    Compare comp;
+    NodePool pool;
+
+    static Node* asNode(NodeBase* n) { return static_cast<Node*>(n); }
+    static const Node* asNode(const NodeBase* n) { return static_cast<const Node*>(n); }
+
+    static int randomHeight() {
+        thread_local uint64_t state =
+            0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(&state) ^
+            static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        uint64_t bits = state;
+        int h = 1;
+        while (h < kMaxLevel && (bits & 3) == 0) {
+            ++h;
+            bits >>= 2;
+        }
+        return h;
+    }
+
+    // Fills preds/succs with the nodes around key on every level. Returns
+    // the highest level on which a node with an equal key was found, or -1.
+    int findSplice(const K& key, NodeBase** preds, NodeBase** succs) const {
+        int found = -1;
+        NodeBase* pred = const_cast<NodeBase*>(&head);
+        for (int l = kMaxLevel - 1; l >= 0; --l) {
+            NodeBase* cur = pred->next[l].load(std::memory_order_acquire);
+            while (cur && comp(asNode(cur)->kv.first, key)) {
+                pred = cur;
+                cur = pred->next[l].load(std::memory_order_acquire);
+            }
+            if (found == -1 && cur && !comp(key, asNode(cur)->kv.first)) found = l;
+            preds[l] = pred;
+            succs[l] = cur;
+        }
+        return found;
+    }
+
+    // First node whose key is not ordered before key (after = false) or
+    // ordered after key (after = true).
+    NodeBase* boundNode(const K& key, bool after) const {
+        const NodeBase* pred = &head;
+        NodeBase* cur = nullptr;
+        for (int l = kMaxLevel - 1; l >= 0; --l) {
+            cur = pred->next[l].load(std::memory_order_acquire);
+            while (cur && (after ? !comp(key, asNode(cur)->kv.first) : comp(asNode(cur)->kv.first, key))) {
+                pred = cur;
+                cur = pred->next[l].load(std::memory_order_acquire);
+            }
+        }
+        return cur;
+    }
+
+    template <typename KK, typename... Args>
+    Node* makeNode(int h, KK&& key, Args&&... args) {
+        void* mem = pool.allocate(h);
+        auto* tower = reinterpret_cast<std::atomic<NodeBase*>*>(static_cast<char*>(mem) + NodePool::towerOffset());
+        return new (mem) Node(tower, h, std::forward<KK>(key), std::forward<Args>(args)...);
+    }
+
+    void destroyNode(Node* node) {
+        int h = node->height;
+        node->~Node();
+        pool.release(node, h);
+    }
+
+    // Links a fully built node between preds and succs. The node's own links
+    // and its successor's prev are set before it is published, so a thread
+    // that reaches it through any level sees it complete.
+    void linkNode(Node* node, NodeBase** preds, NodeBase** succs) {
+        int h = node->height;
+        for (int l = 0; l < h; ++l) node->next[l].store(succs[l], std::memory_order_relaxed);
+        node->prev.store(preds[0], std::memory_order_relaxed);
+        if (succs[0]) succs[0]->prev.store(node, std::memory_order_release);
+        else tail.store(node, std::memory_order_release);
+        for (int l = 0; l < h; ++l) preds[l]->next[l].store(node, std::memory_order_release);
+        node->fullyLinked.store(true, std::memory_order_release);
+        sz.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename KK, typename... Args>
+    std::pair<Node*, bool> insertExclusive(KK&& key, Args&&... args) {
+        NodeBase* preds[kMaxLevel];
+        NodeBase* succs[kMaxLevel];
+        int found = findSplice(key, preds, succs);
+        if (found != -1) return {asNode(succs[found]), false};
+        Node* node = makeNode(randomHeight(), std::forward<KK>(key), std::forward<Args>(args)...);
+        linkNode(node, preds, succs);
+        return {node, true};
+    }
+
+public:
+    template <bool IsConst>
+    class IteratorImpl {
+        using NodePtr = typename std::conditional<IsConst, const NodeBase*, NodeBase*>::type;
+        using ListPtr = typename std::conditional<IsConst, const SkipList*, SkipList*>::type;
+        using Ref = typename std::conditional<IsConst, const std::pair<const K, V>&, std::pair<const K, V>&>::type;
+        using Ptr = typename std::conditional<IsConst, const std::pair<const K, V>*, std::pair<const K, V>*>::type;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::pair<const K, V>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Ptr;
+        using reference = Ref;
+
+        IteratorImpl(ListPtr l, NodePtr node) : list(l), current(node) {}
+
+        reference operator*() const { return nodeRef(); }
+        pointer operator->() const { return &nodeRef(); }
+
+        IteratorImpl& operator++() {
+            current = current->next[0].load(std::memory_order_acquire);
+            return *this;
+        }
+
+        IteratorImpl operator++(int) {
+            IteratorImpl tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        IteratorImpl& operator--() {
+            current = current ? current->prev.load(std::memory_order_acquire)
+                              : list->tail.load(std::memory_order_acquire);
+            return *this;
+        }
+
+        IteratorImpl operator--(int) {
+            IteratorImpl tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const IteratorImpl& other) const { return current == other.current; }
+        bool operator!=(const IteratorImpl& other) const { return current != other.current; }
+
+        operator IteratorImpl<true>() const {
+            return IteratorImpl<true>(list, current);
+        }
+
+    private:
+        friend class SkipList;
+
+        Ref nodeRef() const {
+            using NodeT = typename std::conditional<IsConst, const Node, Node>::type;
+            return static_cast<NodeT*>(current)->kv;
+        }
+
+        ListPtr list;
+        NodePtr current;
+    };
+
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // A half-open key range [lo, hi) that can be walked in either direction.
+    struct Range {
+        const_iterator first;
+        const_iterator last;
+
+        const_iterator begin() const { return first; }
+        const_iterator end() const { return last; }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(last); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(first); }
+    };
+
+    explicit SkipList(Compare c = Compare())
+        : head(headTower, kMaxLevel), tail(nullptr), sz(0), comp(c) {}
+
+    SkipList(std::initializer_list<value_type> init, Compare c = Compare()) : SkipList(c) {
+        for (const auto& kv : init) insert(kv.first, kv.second);
+    }
+
+    SkipList(const SkipList& other) : SkipList(other.comp) {
+        // Keys arrive in order, so every insert lands at the end.
+        for (const auto& kv : other) insert(kv.first, kv.second);
+    }
+
+    SkipList& operator=(const SkipList& other) {
+        if (this != &other) {
+            clear();
+            for (const auto& kv : other) insert(kv.first, kv.second);
+        }
+        return *this;
+    }
+
+    // Nodes live in the pool owned by this object, so moves are not offered.
+    SkipList(SkipList&&) = delete;
+    SkipList& operator=(SkipList&&) = delete;
+
+    ~SkipList() {
+        clear();
+    }
+
+    iterator begin() { return iterator(this, head.next[0].load(std::memory_order_acquire)); }
+    iterator end() { return iterator(this, nullptr); }
+    const_iterator begin() const { return cbegin(); }
+    const_iterator end() const { return cend(); }
+    const_iterator cbegin() const { return const_iterator(this, head.next[0].load(std::memory_order_acquire)); }
+    const_iterator cend() const { return const_iterator(this, nullptr); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+    const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+
+    bool empty() const { return size() == 0; }
+    size_t size() const { return sz.load(std::memory_order_relaxed); }
+
+    // Footprint of the map (see ListMemory.h). Live nodes are walked to size
+    // their towers; free-listed blocks and the unused end of the current
+    // slab are slack. Needs exclusive access.
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m;
+        size_t used = 0;
+        for (const NodeBase* cur = head.next[0].load(std::memory_order_relaxed); cur;
+             cur = cur->next[0].load(std::memory_order_relaxed)) {
+            used += NodePool::blockSize(cur->height);
+        }
+        m.live_bytes = size() * sizeof(value_type);
+        m.overhead_bytes = used - m.live_bytes + sizeof(*this) +
+                           pool.allocation_count() * list_memory::kHeapHeaderBytes;
+        m.slack_bytes = pool.reserved_bytes() - used;
+        return m;
+    }
+
+    // Modifiers (exclusive access)
+
+    std::pair<iterator, bool> insert(const K& key, const V& value) {
+        auto r = insertExclusive(key, value);
+        return {iterator(this, r.first), r.second};
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const K& key, Args&&... args) {
+        auto r = insertExclusive(key, std::forward<Args>(args)...);
+        return {iterator(this, r.first), r.second};
+    }
+
+    V& operator[](const K& key) {
+        return insertExclusive(key).first->kv.second;
+    }
+
+    bool erase(const K& key) {
+        NodeBase* preds[kMaxLevel];
+        NodeBase* succs[kMaxLevel];
+        int found = findSplice(key, preds, succs);
+        if (found == -1) return false;
+        Node* node = asNode(succs[found]);
+        for (int l = 0; l < node->height; ++l) {
+            preds[l]->next[l].store(node->next[l].load(std::memory_order_relaxed), std::memory_order_release);
+        }
+        NodeBase* nxt = node->next[0].load(std::memory_order_relaxed);
+        if (nxt) nxt->prev.store(preds[0], std::memory_order_release);
+        else tail.store(preds[0] == &head ? nullptr : preds[0], std::memory_order_release);
+        destroyNode(node);
+        sz.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void clear() {
+        NodeBase* cur = head.next[0].load(std::memory_order_relaxed);
+        while (cur) {
+            NodeBase* nxt = cur->next[0].load(std::memory_order_relaxed);
+            destroyNode(asNode(cur));
+            cur = nxt;
+        }
+        for (int l = 0; l < kMaxLevel; ++l) head.next[l].store(nullptr, std::memory_order_relaxed);
+        tail.store(nullptr, std::memory_order_relaxed);
+        sz.store(0, std::memory_order_relaxed);
+    }
+
+    // Thread-safe insert. Returns false (and leaves the existing value) if
+    // the key is already present.
+    template <typename... Args>
+    bool concurrent_insert(const K& key, Args&&... args) {
+        NodeBase* preds[kMaxLevel];
+        NodeBase* succs[kMaxLevel];
+        int h = randomHeight();
+        for (;;) {
+            int found = findSplice(key, preds, succs);
+            if (found != -1) {
+                // Another thread may still be linking it; wait so that a
+                // subsequent find() by this thread is guaranteed to see it.
+                while (!succs[found]->fullyLinked.load(std::memory_order_acquire)) std::this_thread::yield();
+                return false;
+            }
+
+            int highestLocked = -1;
+            bool valid = true;
+            for (int l = 0; valid && l < h; ++l) {
+                if (l == 0 || preds[l] != preds[l - 1]) {
+                    preds[l]->lock.lock();
+                    highestLocked = l;
+                }
+                valid = preds[l]->next[l].load(std::memory_order_acquire) == succs[l];
+            }
+
+            if (valid) {
+                Node* node = makeNode(h, key, std::forward<Args>(args)...);
+                linkNode(node, preds, succs);
+            }
+            for (int l = 0; l <= highestLocked; ++l) {
+                if (l == 0 || preds[l] != preds[l - 1]) preds[l]->lock.unlock();
+            }
+            if (valid) return true;
+        }
+    }
+
+    // Lookup (safe alongside concurrent_insert)
+
+    iterator find(const K& key) {
+        NodeBase* node = boundNode(key, false);
+        if (!node || comp(key, asNode(node)->kv.first) || !node->fullyLinked.load(std::memory_order_acquire)) {
+            return end();
+        }
+        return iterator(this, node);
+    }
+
+    const_iterator find(const K& key) const {
+        return const_cast<SkipList*>(this)->find(key);
+    }
+
+    bool contains(const K& key) const {
+        return find(key) != end();
+    }
+
+    V& at(const K& key) {
+        iterator it = find(key);
+        if (it == end()) throw std::out_of_range("at: key not found");
+        return it->second;
+    }
+
+    const V& at(const K& key) const {
+        const_iterator it = find(key);
+        if (it == end()) throw std::out_of_range("at: key not found");
+        return it->second;
+    }
+
+    const_iterator lower_bound(const K& key) const {
+        return const_iterator(this, boundNode(key, false));
+    }
+
+    const_iterator upper_bound(const K& key) const {
+        return const_iterator(this, boundNode(key, true));
+    }
+
+    // Elements with lo <= key < hi, walkable forwards or backwards.
+    Range range(const K& lo, const K& hi) const {
+        if (!comp(lo, hi)) return Range{end(), end()};
+        return Range{lower_bound(lo), lower_bound(hi)};
+    }
+};
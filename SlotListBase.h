@@ -0,0 +1,285 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Shared core of the lists whose nodes live in arrays and refer to each
+// other by slot index instead of by pointer (IndexedLinkedList, CompactList):
+// the head/tail/free-list bookkeeping, linking and unlinking, indexed walks
+// from the nearer end, the bidirectional iterator and the element access
+// and edits built on those.
+//
+// The derived class owns the storage, and with it the layout (parallel
+// arrays, or one array of nodes). It provides, and befriends this class
+// for:
+//
+//   T& valueOf(Index)             the slot's value
+//   Index& nextOf(Index)          the slot's links; free slots are
+//   Index& prevOf(Index)          threaded through nextOf
+//   Index appendSlot(const T&)    a new slot at the end of the storage,
+//                                 holding the value
+//
+// plus const overloads of the three accessors. It may also hide onLink()
+// and onUnlink(), which run before a slot is linked in and after one is
+// unlinked.
+template <typename Derived, typename T, typename Index>
+class SlotListBase {
+public:
+    static constexpr Index npos = static_cast<Index>(-1);
+
+protected:
+    Index head;
+    Index tail;
+    Index freeHead;   // free slots, threaded through nextOf
+    size_t sz;
+
+    SlotListBase() : head(npos), tail(npos), freeHead(npos), sz(0) {}
+
+    Derived& self() { return static_cast<Derived&>(*this); }
+    const Derived& self() const { return static_cast<const Derived&>(*this); }
+
+    void onLink(Index, Index) {}
+    void onUnlink() {}
+
+    void resetLinks() {
+        head = tail = freeHead = npos;
+        sz = 0;
+    }
+
+    Index allocSlot(const T& value) {
+        Index slot;
+        if (freeHead != npos) {
+            slot = freeHead;
+            freeHead = self().nextOf(slot);
+            self().valueOf(slot) = value;
+        } else {
+            slot = self().appendSlot(value);
+        }
+        self().nextOf(slot) = self().prevOf(slot) = npos;
+        return slot;
+    }
+
+    void freeSlot(Index slot) {
+        self().nextOf(slot) = freeHead;
+        self().prevOf(slot) = npos;
+        freeHead = slot;
+    }
+
+    Index slotAt(size_t index) const {
+        if (index >= sz) return npos;
+        Index cur;
+        if (index < sz / 2) {
+            cur = head;
+            for (size_t i = 0; i < index; ++i) cur = self().nextOf(cur);
+        } else {
+            cur = tail;
+            for (size_t i = sz - 1; i > index; --i) cur = self().prevOf(cur);
+        }
+        return cur;
+    }
+
+    void linkBefore(Index pos, Index slot) {
+        self().onLink(pos, slot);
+        Index before = (pos == npos) ? tail : self().prevOf(pos);
+        self().prevOf(slot) = before;
+        self().nextOf(slot) = pos;
+        if (before != npos) self().nextOf(before) = slot;
+        else head = slot;
+        if (pos != npos) self().prevOf(pos) = slot;
+        else tail = slot;
+        ++sz;
+    }
+
+    void unlink(Index slot) {
+        Index p = self().prevOf(slot);
+        Index n = self().nextOf(slot);
+        if (p != npos) self().nextOf(p) = n;
+        else head = n;
+        if (n != npos) self().prevOf(n) = p;
+        else tail = p;
+        freeSlot(slot);
+        --sz;
+        self().onUnlink();
+    }
+
+public:
+    template <bool IsConst>
+    class IteratorImpl {
+        using ListPtr = typename std::conditional<IsConst, const Derived*, Derived*>::type;
+        using BasePtr = typename std::conditional<IsConst, const SlotListBase*, SlotListBase*>::type;
+        using Ref = typename std::conditional<IsConst, const T&, T&>::type;
+        using Ptr = typename std::conditional<IsConst, const T*, T*>::type;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Ptr;
+        using reference = Ref;
+
+        IteratorImpl(ListPtr l, Index slot) : list(l), current(slot) {}
+
+        reference operator*() const { return base()->self().valueOf(current); }
+        pointer operator->() const { return &(base()->self().valueOf(current)); }
+
+        IteratorImpl& operator++() {
+            current = base()->self().nextOf(current);
+            return *this;
+        }
+
+        IteratorImpl operator++(int) {
+            IteratorImpl tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        IteratorImpl& operator--() {
+            current = (current == npos) ? base()->tail : base()->self().prevOf(current);
+            return *this;
+        }
+
+        IteratorImpl operator--(int) {
+            IteratorImpl tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const IteratorImpl& other) const {
+            return current == other.current;
+        }
+
+        bool operator!=(const IteratorImpl& other) const {
+            return current != other.current;
+        }
+
+        operator IteratorImpl<true>() const {
+            return IteratorImpl<true>(list, current);
+        }
+
+        Index slot() const { return current; }
+
+    private:
+        friend class SlotListBase;
+        BasePtr base() const { return list; }
+        ListPtr list;
+        Index current;
+    };
+
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    iterator begin() { return iterator(&self(), head); }
+    iterator end() { return iterator(&self(), npos); }
+    const_iterator begin() const { return cbegin(); }
+    const_iterator end() const { return cend(); }
+    const_iterator cbegin() const { return const_iterator(&self(), head); }
+    const_iterator cend() const { return const_iterator(&self(), npos); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+    const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+
+    bool empty() const { return sz == 0; }
+    size_t size() const { return sz; }
+
+    T& front() {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return self().valueOf(head);
+    }
+
+    const T& front() const {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return self().valueOf(head);
+    }
+
+    T& back() {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        return self().valueOf(tail);
+    }
+
+    const T& back() const {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        return self().valueOf(tail);
+    }
+
+    T& at(size_t index) {
+        if (index >= sz) throw std::out_of_range("at: index out of range");
+        return self().valueOf(slotAt(index));
+    }
+
+    const T& at(size_t index) const {
+        if (index >= sz) throw std::out_of_range("at: index out of range");
+        return self().valueOf(slotAt(index));
+    }
+
+    T& operator[](size_t index) { return at(index); }
+    const T& operator[](size_t index) const { return at(index); }
+
+    // Modifiers
+    void push_front(const T& value) {
+        linkBefore(head, allocSlot(value));
+    }
+
+    void push_back(const T& value) {
+        linkBefore(npos, allocSlot(value));
+    }
+
+    iterator insert(const_iterator pos, const T& value) {
+        Index slot = allocSlot(value);
+        linkBefore(pos.current, slot);
+        return iterator(&self(), slot);
+    }
+
+    bool insert_at(size_t index, const T& value) {
+        if (index > sz) return false;
+        linkBefore(index == sz ? npos : slotAt(index), allocSlot(value));
+        return true;
+    }
+
+    bool pop_front() {
+        if (empty()) return false;
+        unlink(head);
+        return true;
+    }
+
+    bool pop_back() {
+        if (empty()) return false;
+        unlink(tail);
+        return true;
+    }
+
+    bool erase_at(size_t index) {
+        if (index >= sz) return false;
+        unlink(slotAt(index));
+        return true;
+    }
+
+    iterator erase(const_iterator pos) {
+        if (pos.current == npos) return end();
+        Index next = self().nextOf(pos.current);
+        unlink(pos.current);
+        return iterator(&self(), next);
+    }
+
+    bool remove_first(const T& value) {
+        for (Index cur = head; cur != npos; cur = self().nextOf(cur)) {
+            if (self().valueOf(cur) == value) {
+                unlink(cur);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<T> to_vector() const {
+        std::vector<T> v;
+        v.reserve(sz);
+        for (Index cur = head; cur != npos; cur = self().nextOf(cur)) v.push_back(self().valueOf(cur));
+        return v;
+    }
+};
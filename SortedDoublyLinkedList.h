@@ -0,0 +1,439 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "DoublyLinkedList.h"
+#include "ListMemory.h"
+
+// A doubly linked list that keeps its elements ordered by Compare on every
+// insert. The bottom level is an ordinary prev/next node chain, so iteration
+// behaves like DoublyLinkedList; a sparse tower of skip links sits on top of
+// it (each node reaches level l with probability 1/4^l), which makes
+// lookup, insert and erase O(log n) expected instead of a linear scan.
+//
+// Equal elements keep insertion order: a new element goes after any equal
+// ones already in the list.
+template <typename T, typename Compare = std::less<T>>
+class SortedDoublyLinkedList {
+public:
+    static constexpr int kMaxLevel = 24;
+
+private:
+    struct Node {
+        T data;
+        Node* prev;
+        Node* next;       // level 0
+        Node** tower;     // levels 1 .. height-1, or nullptr
+        int height;
+
+        Node(const T& value, int h) : data(value), prev(nullptr), next(nullptr), tower(nullptr), height(h) {
+            if (h > 1) tower = new Node*[h - 1]();
+        }
+        Node(T&& value, int h) : data(std::move(value)), prev(nullptr), next(nullptr), tower(nullptr), height(h) {
+            if (h > 1) tower = new Node*[h - 1]();
+        }
+        ~Node() { delete[] tower; }
+
+        Node*& forward(int level) { return level == 0 ? next : tower[level - 1]; }
+    };
+
+    Node* heads[kMaxLevel];
+    Node* tail;
+    int level;          // number of levels in use
+    size_t sz;
+    Compare comp;
+    uint64_t rngState;
+
+    int randomHeight() {
+        // xorshift64; two random bits per level gives p = 1/4.
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 7;
+        rngState ^= rngState << 17;
+        uint64_t bits = rngState;
+        int h = 1;
+        while (h < kMaxLevel && (bits & 3) == 0) {
+            ++h;
+            bits >>= 2;
+        }
+        return h;
+    }
+
+    Node* nextOf(Node* pred, int l) const {
+        return pred ? pred->forward(l) : heads[l];
+    }
+
+    void setNext(Node* pred, int l, Node* node) {
+        if (pred) pred->forward(l) = node;
+        else heads[l] = node;
+    }
+
+    // Fills update[l] with the last node on level l that is ordered before
+    // value (strictly before when !after, not after value when after);
+    // nullptr stands for the list head.
+    void findPredecessors(const T& value, bool after, Node** update) const {
+        Node* cur = nullptr;
+        for (int l = level - 1; l >= 0; --l) {
+            Node* nxt = nextOf(cur, l);
+            while (nxt && (after ? !comp(value, nxt->data) : comp(nxt->data, value))) {
+                cur = nxt;
+                nxt = cur->forward(l);
+            }
+            update[l] = cur;
+        }
+    }
+
+    const Node* lowerBoundNode(const T& value) const {
+        Node* update[kMaxLevel];
+        findPredecessors(value, false, update);
+        return level ? nextOf(update[0], 0) : nullptr;
+    }
+
+    const Node* upperBoundNode(const T& value) const {
+        Node* update[kMaxLevel];
+        findPredecessors(value, true, update);
+        return level ? nextOf(update[0], 0) : nullptr;
+    }
+
+    // Links node after update[l] on each of its levels.
+    void linkAfter(Node* node, Node** update) {
+        for (int l = level; l < node->height; ++l) update[l] = nullptr;
+        if (node->height > level) level = node->height;
+        for (int l = 0; l < node->height; ++l) {
+            node->forward(l) = nextOf(update[l], l);
+            setNext(update[l], l, node);
+        }
+        node->prev = update[0];
+        if (node->next) node->next->prev = node;
+        else tail = node;
+        ++sz;
+    }
+
+    template <typename V>
+    Node* insertNode(V&& value) {
+        Node* update[kMaxLevel];
+        findPredecessors(value, true, update);
+        Node* node = new Node(std::forward<V>(value), randomHeight());
+        linkAfter(node, update);
+        return node;
+    }
+
+    void unlinkNode(Node* node) {
+        Node* update[kMaxLevel];
+        findPredecessors(node->data, false, update);
+        for (int l = 0; l < node->height; ++l) {
+            Node* pred = update[l];
+            // Step over equal elements that precede node on this level.
+            while (nextOf(pred, l) != node) pred = nextOf(pred, l);
+            setNext(pred, l, node->forward(l));
+        }
+        if (node->next) node->next->prev = node->prev;
+        else tail = node->prev;
+        while (level > 0 && !heads[level - 1]) --level;
+        delete node;
+        --sz;
+    }
+
+    // Appends a value known to be >= every element; tails[l] is the last
+    // node on level l so far. Used for O(n) bulk construction.
+    void appendOrdered(const T& value, Node** tails) {
+        Node* node = new Node(value, randomHeight());
+        for (int l = level; l < node->height; ++l) tails[l] = nullptr;
+        if (node->height > level) level = node->height;
+        for (int l = 0; l < node->height; ++l) {
+            setNext(tails[l], l, node);
+            tails[l] = node;
+        }
+        node->prev = tail;
+        tail = node;
+        ++sz;
+    }
+
+    template <typename InputIt>
+    void buildFromOrdered(InputIt first, InputIt last) {
+        Node* tails[kMaxLevel] = {};
+        for (; first != last; ++first) appendOrdered(*first, tails);
+    }
+
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator(const SortedDoublyLinkedList* l, const Node* node) : list(l), current(node) {}
+
+        reference operator*() const { return current->data; }
+        pointer operator->() const { return &(current->data); }
+
+        const_iterator& operator++() {
+            current = current->next;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        const_iterator& operator--() {
+            current = current ? current->prev : list->tail;
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const { return current == other.current; }
+        bool operator!=(const const_iterator& other) const { return current != other.current; }
+
+    private:
+        friend class SortedDoublyLinkedList;
+        const SortedDoublyLinkedList* list;
+        const Node* current;
+    };
+
+    // Elements are immutable in place: changing one could break the order.
+    using iterator = const_iterator;
+    using reverse_iterator = std::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = reverse_iterator;
+
+    explicit SortedDoublyLinkedList(Compare c = Compare())
+        : heads(), tail(nullptr), level(0), sz(0), comp(c), rngState(0x9E3779B97F4A7C15ull) {}
+
+    SortedDoublyLinkedList(std::initializer_list<T> init, Compare c = Compare())
+        : SortedDoublyLinkedList(c) {
+        for (const auto& val : init) insert(val);
+    }
+
+    explicit SortedDoublyLinkedList(const DoublyLinkedList<T>& list, Compare c = Compare())
+        : SortedDoublyLinkedList(c) {
+        std::vector<T> vec = list.to_vector();
+        std::stable_sort(vec.begin(), vec.end(), comp);
+        buildFromOrdered(vec.begin(), vec.end());
+    }
+
+    SortedDoublyLinkedList(const SortedDoublyLinkedList& other) : SortedDoublyLinkedList(other.comp) {
+        buildFromOrdered(other.begin(), other.end());
+    }
+
+    SortedDoublyLinkedList& operator=(const SortedDoublyLinkedList& other) {
+        if (this != &other) {
+            clear();
+            comp = other.comp;
+            buildFromOrdered(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SortedDoublyLinkedList(SortedDoublyLinkedList&& other) noexcept
+        : tail(other.tail), level(other.level), sz(other.sz), comp(std::move(other.comp)), rngState(other.rngState) {
+        for (int l = 0; l < kMaxLevel; ++l) heads[l] = other.heads[l];
+        other.releaseAll();
+    }
+
+    SortedDoublyLinkedList& operator=(SortedDoublyLinkedList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            for (int l = 0; l < kMaxLevel; ++l) heads[l] = other.heads[l];
+            tail = other.tail;
+            level = other.level;
+            sz = other.sz;
+            comp = std::move(other.comp);
+            other.releaseAll();
+        }
+        return *this;
+    }
+
+    ~SortedDoublyLinkedList() {
+        clear();
+    }
+
+    const_iterator begin() const { return const_iterator(this, heads[0]); }
+    const_iterator end() const { return const_iterator(this, nullptr); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    bool empty() const { return sz == 0; }
+    size_t size() const { return sz; }
+
+    // Footprint of the list (see ListMemory.h). Walks the nodes to add up
+    // their separately allocated skip towers.
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m;
+        list_memory::add_nodes(m, sz, sizeof(Node), sizeof(T));
+        for (const Node* cur = heads[0]; cur; cur = cur->next) {
+            if (cur->height <= 1) continue;
+            size_t towerBytes = static_cast<size_t>(cur->height - 1) * sizeof(Node*);
+            m.overhead_bytes += towerBytes;
+            list_memory::add_heap_block(m, towerBytes);
+        }
+        m.overhead_bytes += sizeof(*this);
+        return m;
+    }
+
+    const T& front() const {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return heads[0]->data;
+    }
+
+    const T& back() const {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        return tail->data;
+    }
+
+    // Modifiers
+    const_iterator insert(const T& value) {
+        return const_iterator(this, insertNode(value));
+    }
+
+    const_iterator insert(T&& value) {
+        return const_iterator(this, insertNode(std::move(value)));
+    }
+
+    // Merges an already sorted batch in one pass. The search on every level
+    // resumes from where the previous element stopped, so k elements cost
+    // O(n + k log n) rather than k independent searches from the head.
+    template <typename InputIt>
+    void merge_sorted(InputIt first, InputIt last) {
+        Node* update[kMaxLevel];
+        for (int l = 0; l < kMaxLevel; ++l) update[l] = nullptr;
+        for (; first != last; ++first) {
+            const T& value = *first;
+            for (int l = level - 1; l >= 0; --l) {
+                Node* cur = update[l];
+                Node* nxt = nextOf(cur, l);
+                while (nxt && !comp(value, nxt->data)) {
+                    cur = nxt;
+                    nxt = cur->forward(l);
+                }
+                update[l] = cur;
+            }
+            Node* node = new Node(value, randomHeight());
+            linkAfter(node, update);
+            for (int l = 0; l < node->height; ++l) update[l] = node;
+        }
+    }
+
+    // Sorts a copy of the batch first, then merges it.
+    template <typename InputIt>
+    void insert_range(InputIt first, InputIt last) {
+        std::vector<T> batch(first, last);
+        std::stable_sort(batch.begin(), batch.end(), comp);
+        merge_sorted(batch.begin(), batch.end());
+    }
+
+    // Removes the first element equal to value.
+    bool erase(const T& value) {
+        const Node* node = lowerBoundNode(value);
+        if (!node || comp(value, node->data)) return false;
+        unlinkNode(const_cast<Node*>(node));
+        return true;
+    }
+
+    const_iterator erase(const_iterator pos) {
+        if (!pos.current) return end();
+        Node* node = const_cast<Node*>(pos.current);
+        Node* nxt = node->next;
+        unlinkNode(node);
+        return const_iterator(this, nxt);
+    }
+
+    bool pop_front() {
+        if (empty()) return false;
+        erase(begin());
+        return true;
+    }
+
+    bool pop_back() {
+        if (empty()) return false;
+        unlinkNode(tail);
+        return true;
+    }
+
+    void clear() {
+        Node* cur = heads[0];
+        while (cur) {
+            Node* nxt = cur->next;
+            delete cur;
+            cur = nxt;
+        }
+        releaseAll();
+    }
+
+    // Lookup
+    const_iterator lower_bound(const T& value) const {
+        return const_iterator(this, lowerBoundNode(value));
+    }
+
+    const_iterator upper_bound(const T& value) const {
+        return const_iterator(this, upperBoundNode(value));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const T& value) const {
+        return {lower_bound(value), upper_bound(value)};
+    }
+
+    const_iterator find(const T& value) const {
+        const Node* node = lowerBoundNode(value);
+        if (!node || comp(value, node->data)) return end();
+        return const_iterator(this, node);
+    }
+
+    bool contains(const T& value) const {
+        return find(value) != end();
+    }
+
+    size_t count(const T& value) const {
+        auto range = equal_range(value);
+        return static_cast<size_t>(std::distance(range.first, range.second));
+    }
+
+    DoublyLinkedList<T> to_doubly_linked_list() const {
+        DoublyLinkedList<T> list;
+        for (const auto& val : *this) list.push_back(val);
+        return list;
+    }
+
+    std::vector<T> to_vector() const {
+        std::vector<T> v;
+        v.reserve(sz);
+        for (const auto& val : *this) v.push_back(val);
+        return v;
+    }
+
+private:
+    void releaseAll() {
+        for (int l = 0; l < kMaxLevel; ++l) heads[l] = nullptr;
+        tail = nullptr;
+        level = 0;
+        sz = 0;
+    }
+};
+
+template <typename T, typename C>
+bool operator==(const SortedDoublyLinkedList<T, C>& lhs, const SortedDoublyLinkedList<T, C>& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename C>
+bool operator!=(const SortedDoublyLinkedList<T, C>& lhs, const SortedDoublyLinkedList<T, C>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,363 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "ListMemory.h"
+
+// Doubly linked list of at most Capacity elements whose nodes live in an
+// array inside the object and link to each other by index. Nothing is ever
+// allocated, so for a literal T the list is a literal type and every
+// operation is constexpr, under C++17 already. A table built by a constexpr
+// function can be kept in a constexpr variable, which the compiler emits as
+// read-only data: the program starts with the table in place instead of
+// building it.
+//
+//   constexpr auto kRoutes = [] {
+//       StaticDoublyLinkedList<Route, 64> table;
+//       table.push_back(Route{...});
+//       return table;
+//   }();
+//
+// Slot Capacity is a sentinel, as in CircularDoublyLinkedList: it is end(),
+// its next is the front and its prev the back, so inserts and erases need no
+// head/tail special case. Links use the smallest unsigned type that can
+// index Capacity + 1 slots. Slots are handed out in order and erased ones
+// are reused through a free list threaded through next.
+//
+// T must be default constructible: every slot holds a T, and the slot of an
+// erased element is reset to T(). Inserting into a full list throws
+// std::length_error, which in constant evaluation is a compile error.
+template <typename T, size_t Capacity>
+class StaticDoublyLinkedList {
+    static_assert(Capacity > 0, "StaticDoublyLinkedList needs a capacity");
+    static_assert(Capacity < UINT32_MAX, "StaticDoublyLinkedList capacity too large");
+
+private:
+    using Index = typename std::conditional<
+        (Capacity <= UINT8_MAX), uint8_t,
+        typename std::conditional<(Capacity <= UINT16_MAX), uint16_t, uint32_t>::type>::type;
+
+    static constexpr Index kSentinel = static_cast<Index>(Capacity);
+
+    struct Link {
+        Index prev = kSentinel;
+        Index next = kSentinel;
+    };
+
+    T values[Capacity] = {};
+    Link links[Capacity + 1] = {};
+    Index freeHead = kSentinel;
+    Index used = 0;   // slots [0, used) have been handed out at least once
+    Index sz = 0;
+
+    constexpr Index acquire() {
+        if (freeHead != kSentinel) {
+            Index slot = freeHead;
+            freeHead = links[slot].next;
+            return slot;
+        }
+        if (used == Capacity) throw std::length_error("StaticDoublyLinkedList: capacity exhausted");
+        return used++;
+    }
+
+    // Stores a new element in a free slot and links it in front of pos.
+    template <typename... Args>
+    constexpr Index insertBefore(Index pos, Args&&... args) {
+        T value(std::forward<Args>(args)...);
+        Index slot = acquire();
+        values[slot] = std::move(value);
+        Index before = links[pos].prev;
+        links[slot].prev = before;
+        links[slot].next = pos;
+        links[before].next = slot;
+        links[pos].prev = slot;
+        ++sz;
+        return slot;
+    }
+
+    // Unlinks slot, resets its value and returns the slot that followed it.
+    constexpr Index eraseSlot(Index slot) {
+        Index prev = links[slot].prev;
+        Index next = links[slot].next;
+        links[prev].next = next;
+        links[next].prev = prev;
+        values[slot] = T();
+        links[slot].prev = kSentinel;
+        links[slot].next = freeHead;
+        freeHead = slot;
+        --sz;
+        return next;
+    }
+
+    // Slot of the element at index, or the sentinel for index == size().
+    // Walks from the nearer end.
+    constexpr Index slotAt(size_t index) const {
+        Index cur = kSentinel;
+        if (index < sz - index) {
+            for (size_t i = 0; i <= index; ++i) cur = links[cur].next;
+        } else {
+            for (size_t i = sz; i > index; --i) cur = links[cur].prev;
+        }
+        return cur;
+    }
+
+public:
+    template <bool IsConst>
+    class IteratorImpl {
+        using ListPtr = typename std::conditional<IsConst, const StaticDoublyLinkedList*,
+                                                  StaticDoublyLinkedList*>::type;
+        using Ref = typename std::conditional<IsConst, const T&, T&>::type;
+        using Ptr = typename std::conditional<IsConst, const T*, T*>::type;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Ptr;
+        using reference = Ref;
+
+        constexpr IteratorImpl() : list(nullptr), current(kSentinel) {}
+        constexpr IteratorImpl(ListPtr l, Index slot) : list(l), current(slot) {}
+
+        constexpr reference operator*() const { return list->values[current]; }
+        constexpr pointer operator->() const { return &list->values[current]; }
+
+        constexpr IteratorImpl& operator++() {
+            current = list->links[current].next;
+            return *this;
+        }
+
+        constexpr IteratorImpl operator++(int) {
+            IteratorImpl tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        constexpr IteratorImpl& operator--() {
+            current = list->links[current].prev;
+            return *this;
+        }
+
+        constexpr IteratorImpl operator--(int) {
+            IteratorImpl tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        constexpr bool operator==(const IteratorImpl& other) const { return current == other.current; }
+        constexpr bool operator!=(const IteratorImpl& other) const { return current != other.current; }
+
+        constexpr operator IteratorImpl<true>() const { return IteratorImpl<true>(list, current); }
+
+    private:
+        friend class StaticDoublyLinkedList;
+        ListPtr list;
+        Index current;
+    };
+
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    constexpr StaticDoublyLinkedList() = default;
+
+    constexpr StaticDoublyLinkedList(std::initializer_list<T> init) : StaticDoublyLinkedList() {
+        for (const auto& val : init) push_back(val);
+    }
+
+    constexpr iterator begin() { return iterator(this, links[kSentinel].next); }
+    constexpr iterator end() { return iterator(this, kSentinel); }
+    constexpr const_iterator begin() const { return cbegin(); }
+    constexpr const_iterator end() const { return cend(); }
+    constexpr const_iterator cbegin() const { return const_iterator(this, links[kSentinel].next); }
+    constexpr const_iterator cend() const { return const_iterator(this, kSentinel); }
+    constexpr reverse_iterator rbegin() { return reverse_iterator(end()); }
+    constexpr reverse_iterator rend() { return reverse_iterator(begin()); }
+    constexpr const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+    constexpr const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+
+    constexpr bool empty() const { return sz == 0; }
+    constexpr size_t size() const { return sz; }
+    constexpr bool full() const { return sz == Capacity; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    // Footprint of the list (see ListMemory.h). All of it is the object
+    // itself: the unused slots are slack and the links overhead.
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m;
+        m.live_bytes = sz * sizeof(T);
+        m.slack_bytes = (Capacity - sz) * sizeof(T);
+        m.overhead_bytes = sizeof(*this) - Capacity * sizeof(T);
+        return m;
+    }
+
+    constexpr T& front() {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return values[links[kSentinel].next];
+    }
+
+    constexpr const T& front() const {
+        if (empty()) throw std::out_of_range("front: list is empty");
+        return values[links[kSentinel].next];
+    }
+
+    constexpr T& back() {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        return values[links[kSentinel].prev];
+    }
+
+    constexpr const T& back() const {
+        if (empty()) throw std::out_of_range("back: list is empty");
+        return values[links[kSentinel].prev];
+    }
+
+    constexpr T& at(size_t index) {
+        if (index >= sz) throw std::out_of_range("at: index out of range");
+        return values[slotAt(index)];
+    }
+
+    constexpr const T& at(size_t index) const {
+        if (index >= sz) throw std::out_of_range("at: index out of range");
+        return values[slotAt(index)];
+    }
+
+    constexpr T& operator[](size_t index) { return at(index); }
+    constexpr const T& operator[](size_t index) const { return at(index); }
+
+    // Modifiers
+
+    constexpr void push_front(const T& value) { insertBefore(links[kSentinel].next, value); }
+    constexpr void push_front(T&& value) { insertBefore(links[kSentinel].next, std::move(value)); }
+    constexpr void push_back(const T& value) { insertBefore(kSentinel, value); }
+    constexpr void push_back(T&& value) { insertBefore(kSentinel, std::move(value)); }
+
+    template <typename... Args>
+    constexpr void emplace_front(Args&&... args) {
+        insertBefore(links[kSentinel].next, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    constexpr void emplace_back(Args&&... args) {
+        insertBefore(kSentinel, std::forward<Args>(args)...);
+    }
+
+    constexpr iterator insert(const_iterator pos, const T& value) {
+        return iterator(this, insertBefore(pos.current, value));
+    }
+
+    constexpr iterator insert(const_iterator pos, T&& value) {
+        return iterator(this, insertBefore(pos.current, std::move(value)));
+    }
+
+    template <typename... Args>
+    constexpr iterator emplace(const_iterator pos, Args&&... args) {
+        return iterator(this, insertBefore(pos.current, std::forward<Args>(args)...));
+    }
+
+    // index == size() appends.
+    constexpr bool insert_at(size_t index, const T& value) {
+        if (index > sz) return false;
+        insertBefore(slotAt(index), value);
+        return true;
+    }
+
+    constexpr bool insert_at(size_t index, T&& value) {
+        if (index > sz) return false;
+        insertBefore(slotAt(index), std::move(value));
+        return true;
+    }
+
+    constexpr bool pop_front() {
+        if (empty()) return false;
+        eraseSlot(links[kSentinel].next);
+        return true;
+    }
+
+    constexpr bool pop_back() {
+        if (empty()) return false;
+        eraseSlot(links[kSentinel].prev);
+        return true;
+    }
+
+    constexpr bool erase_at(size_t index) {
+        if (index >= sz) return false;
+        eraseSlot(slotAt(index));
+        return true;
+    }
+
+    // Erasing end() is a no-op that returns end().
+    constexpr iterator erase(const_iterator pos) {
+        if (pos.current == kSentinel) return end();
+        return iterator(this, eraseSlot(pos.current));
+    }
+
+    // Erases [first, last) and returns last.
+    constexpr iterator erase(const_iterator first, const_iterator last) {
+        Index cur = first.current;
+        while (cur != last.current) cur = eraseSlot(cur);
+        return iterator(this, last.current);
+    }
+
+    // Empties the list and forgets the slot order, so that refilling it
+    // lays the elements out in array order again.
+    constexpr void clear() {
+        for (Index slot = 0; slot < used; ++slot) {
+            values[slot] = T();
+            links[slot] = Link();
+        }
+        links[kSentinel] = Link();
+        freeHead = kSentinel;
+        used = 0;
+        sz = 0;
+    }
+
+    // Swaps the links of every element and of the sentinel. O(n).
+    constexpr void reverse() {
+        Index cur = kSentinel;
+        do {
+            Link& link = links[cur];
+            Index next = link.next;
+            link.next = link.prev;
+            link.prev = next;
+            cur = next;
+        } while (cur != kSentinel);
+    }
+
+    constexpr bool contains(const T& value) const {
+        for (const auto& v : *this) {
+            if (v == value) return true;
+        }
+        return false;
+    }
+
+    constexpr int find_first_index(const T& value) const {
+        int index = 0;
+        for (const auto& v : *this) {
+            if (v == value) return index;
+            ++index;
+        }
+        return -1;
+    }
+};
+
+template <typename T, size_t N>
+constexpr bool operator==(const StaticDoublyLinkedList<T, N>& lhs, const StaticDoublyLinkedList<T, N>& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    auto a = lhs.begin();
+    for (auto b = rhs.begin(); b != rhs.end(); ++a, ++b) {
+        if (!(*a == *b)) return false;
+    }
+    return true;
+}
+
+template <typename T, size_t N>
+constexpr bool operator!=(const StaticDoublyLinkedList<T, N>& lhs, const StaticDoublyLinkedList<T, N>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "CircularDoublyLinkedList.h"
+
+// Hierarchical timing wheel (Varghese & Lauck) over CircularDoublyLinkedList
+// buckets. Four levels of 64 slots cover 2^24 ticks at full resolution;
+// level l holds timers due within 64^(l+1) ticks, bucketed by bits
+// 6l..6l+5 of their expiry tick. Every 64^l ticks, one level-l bucket is
+// cascaded: its timers are re-bucketed into lower levels, and in time they
+// reach level 0, whose bucket for the current tick is fired. Timers further
+// out than 2^24 ticks sit in the top level and are re-bucketed until they
+// come in range.
+//
+// schedule() and cancel() are O(1), and tick() is O(1) plus the timers it
+// fires or cascades (each timer cascades at most three times). Timer nodes
+// only ever move between buckets by splice(): fired and cancelled nodes go
+// to a free list and are reused by later schedule() calls, so a wheel in
+// steady state does not allocate. shrink_to_fit() frees the spare nodes.
+//
+// T is the payload handed to the tick() callback, e.g. a task id or a
+// std::function<void()>.
+template <typename T>
+class TimerWheel {
+public:
+    static constexpr unsigned kSlotBits = 6;
+    static constexpr unsigned kSlots = 1u << kSlotBits;
+    static constexpr unsigned kLevels = 4;
+    static constexpr uint64_t kRange = uint64_t(1) << (kSlotBits * kLevels);
+
+private:
+    static constexpr uint8_t kFiring = kLevels;   // Entry::level while in firing
+    static constexpr uint8_t kFree = kLevels + 1;
+
+    struct Entry {
+        std::optional<T> payload;
+        uint64_t expires = 0;
+        uint64_t serial = 0;
+        uint8_t level = kFree;
+        uint8_t slot = 0;
+    };
+
+    using Bucket = CircularDoublyLinkedList<Entry>;
+
+public:
+    // Identifies one scheduled timer. Stays safe to pass to cancel() after
+    // the timer fired or was cancelled (cancel() then returns false): the
+    // node it points at belongs to the wheel until the wheel is destroyed or
+    // shrink_to_fit() runs, and its serial no longer matches.
+    class TimerId {
+    public:
+        TimerId() : serial(0) {}
+
+    private:
+        friend class TimerWheel;
+        TimerId(typename Bucket::iterator i, uint64_t s) : it(i), serial(s) {}
+
+        typename Bucket::iterator it;
+        uint64_t serial;
+    };
+
+    TimerWheel() : current(0), pending(0), nextSerial(1) {}
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Ticks processed so far.
+    uint64_t now() const { return current; }
+    size_t size() const { return pending; }
+    bool empty() const { return pending == 0; }
+
+    // Fires payload on the tick now() + delay; a delay of 0 fires on the
+    // next tick.
+    TimerId schedule(uint64_t delay, T payload) {
+        if (delay == 0) delay = 1;
+        uint64_t expires = current + delay;
+        if (expires < current) expires = UINT64_MAX;   // saturate far-future timers
+        if (spare.empty()) spare.emplace_back();
+        auto it = spare.begin();
+        it->payload.emplace(std::move(payload));
+        it->expires = expires;
+        it->serial = nextSerial++;
+        Bucket& target = place(*it);
+        target.splice(target.end(), spare, it);
+        ++pending;
+        return TimerId(it, it->serial);
+    }
+
+    // Cancels a pending timer; false if it already fired or was cancelled.
+    bool cancel(const TimerId& id) {
+        if (id.serial == 0 || id.it->serial != id.serial || id.it->level == kFree) return false;
+        recycle(bucketOf(*id.it), id.it);
+        --pending;
+        return true;
+    }
+
+    // Advances one tick and calls on_expire(T&) for every timer due on it.
+    // The callback may schedule and cancel timers. If it throws, the timers
+    // not yet fired are fired first on the next call.
+    template <typename F>
+    size_t tick(F&& on_expire) {
+        size_t fired = fireFiring(on_expire);
+        ++current;
+        for (unsigned level = 1; level < kLevels; ++level) {
+            if (((current >> (kSlotBits * (level - 1))) & (kSlots - 1)) != 0) break;
+            cascade(level, (current >> (kSlotBits * level)) & (kSlots - 1));
+        }
+        Bucket& due = slots[0][current & (kSlots - 1)];
+        for (auto& e : due) e.level = kFiring;
+        firing.splice(firing.end(), due);
+        return fired + fireFiring(on_expire);
+    }
+
+    // Runs tick() n times; returns the number of timers fired.
+    template <typename F>
+    size_t advance(uint64_t n, F&& on_expire) {
+        size_t fired = 0;
+        for (uint64_t i = 0; i < n; ++i) fired += tick(on_expire);
+        return fired;
+    }
+
+    // Frees the nodes kept for reuse. TimerIds of fired or cancelled timers
+    // must not be used afterwards.
+    void shrink_to_fit() { spare.clear(); }
+
+    ListMemoryUsage memory_usage() const {
+        ListMemoryUsage m = spare.memory_usage();
+        m.slack_bytes += m.live_bytes;   // spare nodes hold no timer
+        m.live_bytes = 0;
+        m += firing.memory_usage();
+        for (const auto& level : slots) {
+            for (const auto& bucket : level) m += bucket.memory_usage();
+        }
+        return m;
+    }
+
+private:
+    Bucket slots[kLevels][kSlots];
+    Bucket firing;   // due on the current tick, not yet handed to the callback
+    Bucket spare;    // recycled nodes
+    uint64_t current;
+    size_t pending;
+    uint64_t nextSerial;
+
+    // Records in e the bucket its expiry maps to as seen from now(), and
+    // returns that bucket. A timer goes to the lowest level whose next level
+    // up has the expiry in the same block as now(), so it is cascaded down
+    // exactly when now() enters its block of that level.
+    Bucket& place(Entry& e) {
+        uint64_t expires = e.expires;
+        if (expires - current >= kRange) expires = current + kRange - 1;
+        unsigned level = 0;
+        while (level + 1 < kLevels &&
+               (expires >> (kSlotBits * (level + 1))) != (current >> (kSlotBits * (level + 1)))) {
+            ++level;
+        }
+        unsigned slot = (expires >> (kSlotBits * level)) & (kSlots - 1);
+        e.level = static_cast<uint8_t>(level);
+        e.slot = static_cast<uint8_t>(slot);
+        return slots[level][slot];
+    }
+
+    Bucket& bucketOf(const Entry& e) {
+        return e.level == kFiring ? firing : slots[e.level][e.slot];
+    }
+
+    void recycle(Bucket& from, typename Bucket::iterator it) {
+        it->payload.reset();
+        it->level = kFree;
+        ++it->serial;   // stale TimerIds stop matching
+        spare.splice(spare.end(), from, it);
+    }
+
+    // Re-buckets every timer in slots[level][slot] relative to now().
+    void cascade(unsigned level, unsigned slot) {
+        Bucket& bucket = slots[level][slot];
+        while (!bucket.empty()) {
+            auto it = bucket.begin();
+            Bucket& target = place(*it);
+            target.splice(target.end(), bucket, it);
+        }
+    }
+
+    template <typename F>
+    size_t fireFiring(F& on_expire) {
+        size_t fired = 0;
+        while (!firing.empty()) {
+            auto it = firing.begin();
+            --pending;
+            ++fired;
+            ++it->serial;   // cancelling itself from the callback is a no-op
+            it->level = kFree;
+            struct Recycle {
+                TimerWheel* wheel;
+                typename Bucket::iterator it;
+                ~Recycle() {
+                    it->payload.reset();
+                    wheel->spare.splice(wheel->spare.end(), wheel->firing, it);
+                }
+            } recycleAfter{this, it};
+            on_expire(*it->payload);
+        }
+        return fired;
+    }
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Small self-contained benchmark helpers shared by the benchmark programs.
+// Results are printed as a JSON array so they can be diffed between runs.
+
+class BenchTimer {
+public:
+    BenchTimer() : start(std::chrono::steady_clock::now()) {}
+
+    void reset() { start = std::chrono::steady_clock::now(); }
+
+    double elapsed_ns() const {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+// Keeps the optimizer from discarding a computed value.
+template <typename T>
+inline void bench_do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class BenchReporter {
+public:
+    struct Field {
+        std::string key;
+        std::string value;   // already JSON-encoded
+    };
+
+    class Record {
+    public:
+        Record& set(const std::string& key, const std::string& value) {
+            fields.push_back({key, "\"" + value + "\""});
+            return *this;
+        }
+
+        Record& set(const std::string& key, const char* value) {
+            return set(key, std::string(value));
+        }
+
+        Record& set(const std::string& key, double value) {
+            fields.push_back({key, std::to_string(value)});
+            return *this;
+        }
+
+        Record& set(const std::string& key, uint64_t value) {
+            fields.push_back({key, std::to_string(value)});
+            return *this;
+        }
+
+        Record& set(const std::string& key, int value) {
+            fields.push_back({key, std::to_string(value)});
+            return *this;
+        }
+
+    private:
+        friend class BenchReporter;
+        std::vector<Field> fields;
+    };
+
+    Record& add(const std::string& benchmark) {
+        records.emplace_back();
+        records.back().set("benchmark", benchmark);
+        return records.back();
+    }
+
+    void print(std::ostream& os = std::cout) const {
+        os << "[\n";
+        for (size_t i = 0; i < records.size(); ++i) {
+            os << "  {";
+            const auto& fields = records[i].fields;
+            for (size_t j = 0; j < fields.size(); ++j) {
+                os << "\"" << fields[j].key << "\": " << fields[j].value;
+                if (j + 1 < fields.size()) os << ", ";
+            }
+            os << "}";
+            if (i + 1 < records.size()) os << ",";
+            os << "\n";
+        }
+        os << "]\n";
+    }
+
+private:
+    std::deque<Record> records;
+};
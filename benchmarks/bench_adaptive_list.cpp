@@ -0,0 +1,130 @@
+// AdaptiveList on mixed operation traces, against the same list pinned to
+// each layout. Traces: "indexed" (mostly random operator[] plus appends
+// and an occasional sort), "front_edits" (mostly insert_at/erase_at near
+// the front), "phased" (the two alternating every phase_ops operations) and
+// "even" (random reads and front inserts half and half, to show the
+// hysteresis keeping the list from flapping).
+//
+// usage: bench_adaptive_list [n] [ops] [phase_ops]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../AdaptiveList.h"
+#include "BenchHarness.h"
+
+namespace {
+
+enum class Op : uint8_t { Read, Append, InsertFront, EraseFront, Sort };
+
+struct Step {
+    Op op;
+    uint32_t arg;
+};
+
+using Trace = std::vector<Step>;
+
+Step indexedStep(std::mt19937& rng) {
+    unsigned r = rng() % 1000;
+    if (r < 900) return {Op::Read, static_cast<uint32_t>(rng())};
+    if (r < 999) return {Op::Append, static_cast<uint32_t>(rng())};
+    return {Op::Sort, 0};
+}
+
+Step frontStep(std::mt19937& rng) {
+    unsigned r = rng() % 100;
+    if (r < 49) return {Op::InsertFront, static_cast<uint32_t>(rng() % 8)};
+    if (r < 98) return {Op::EraseFront, static_cast<uint32_t>(rng() % 8)};
+    return {Op::Read, static_cast<uint32_t>(rng())};
+}
+
+Trace makeTrace(const char* kind, size_t ops, size_t phaseOps, std::mt19937& rng) {
+    Trace trace;
+    trace.reserve(ops);
+    std::string k(kind);
+    for (size_t i = 0; i < ops; ++i) {
+        if (k == "indexed") {
+            trace.push_back(indexedStep(rng));
+        } else if (k == "front_edits") {
+            trace.push_back(frontStep(rng));
+        } else if (k == "phased") {
+            trace.push_back((i / phaseOps) % 2 == 0 ? indexedStep(rng) : frontStep(rng));
+        } else {
+            trace.push_back(rng() % 2 ? Step{Op::Read, static_cast<uint32_t>(rng())}
+                                      : Step{Op::InsertFront, static_cast<uint32_t>(rng() % 8)});
+        }
+    }
+    return trace;
+}
+
+long long replay(AdaptiveList<int>& list, const Trace& trace) {
+    long long acc = 0;
+    for (const Step& s : trace) {
+        switch (s.op) {
+        case Op::Read:
+            if (!list.empty()) acc += list[s.arg % list.size()];
+            break;
+        case Op::Append:
+            list.push_back(static_cast<int>(s.arg));
+            break;
+        case Op::InsertFront:
+            list.insert_at(std::min<size_t>(s.arg, list.size()), static_cast<int>(s.arg));
+            break;
+        case Op::EraseFront:
+            if (!list.empty()) list.erase_at(std::min<size_t>(s.arg, list.size() - 1));
+            break;
+        case Op::Sort:
+            list.sort_ascending();
+            break;
+        }
+    }
+    return acc;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    size_t ops = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+    size_t phaseOps = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 20000;
+    if (phaseOps == 0) phaseOps = 1;
+
+    using R = ListRepresentation;
+    struct Mode {
+        const char* name;
+        bool pinned;
+        R rep;
+    };
+    const Mode modes[] = {{"adaptive", false, R::Contiguous},
+                          {"pinned_contiguous", true, R::Contiguous},
+                          {"pinned_linked", true, R::Linked}};
+
+    BenchReporter report;
+    for (const char* kind : {"indexed", "front_edits", "phased", "even"}) {
+        std::mt19937 rng(17);
+        Trace trace = makeTrace(kind, ops, phaseOps, rng);
+        for (const Mode& mode : modes) {
+            AdaptiveList<int> list;
+            for (size_t i = 0; i < n; ++i) list.push_back(static_cast<int>(i));
+            if (mode.pinned) list.pin(mode.rep);
+            BenchTimer timer;
+            long long acc = replay(list, trace);
+            double ns = timer.elapsed_ns();
+            bench_do_not_optimize(acc);
+            report.add("adaptive_list")
+                .set("trace", kind)
+                .set("mode", mode.name)
+                .set("n", static_cast<uint64_t>(n))
+                .set("ops", static_cast<uint64_t>(ops))
+                .set("ms", ns / 1e6)
+                .set("migrations", static_cast<uint64_t>(list.migrations()))
+                .set("final_layout", list.representation() == R::Contiguous ? "contiguous" : "linked");
+        }
+    }
+    report.print();
+    return 0;
+}
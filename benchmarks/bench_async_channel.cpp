@@ -0,0 +1,215 @@
+// Three-stage pipeline (producer -> transform -> consumer) connected by two
+// AsyncListChannels. Reports throughput and per-item latency (time from
+// production to consumption) for the single-thread and thread-pool
+// executors, single pop() against pop_n() batches, and a busy-polling
+// DoublyLinkedList-behind-a-mutex baseline.
+//
+// usage: bench_async_channel [items] [capacity] [batch] [pool_threads]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <latch>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../AsyncListChannel.h"
+#include "../DoublyLinkedList.h"
+#include "BenchHarness.h"
+
+namespace {
+
+struct Item {
+    uint64_t value;
+    int64_t producedNs;
+};
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct Config {
+    size_t items;
+    size_t capacity;
+    size_t batch;   // 1 = pop(), otherwise pop_n(batch)
+};
+
+struct Result {
+    double totalNs;
+    std::vector<int64_t> latencies;
+};
+
+ChannelTask producer(AsyncListChannel<Item>& out, size_t n) {
+    for (size_t i = 0; i < n; ++i) co_await out.push(Item{i, nowNs()});
+    out.close();
+}
+
+ChannelTask transform(AsyncListChannel<Item>& in, AsyncListChannel<Item>& out, size_t batch) {
+    if (batch == 1) {
+        while (auto item = co_await in.pop()) {
+            item->value = item->value * 2 + 1;
+            co_await out.push(*item);
+        }
+    } else {
+        for (;;) {
+            DoublyLinkedList<Item> got = co_await in.pop_n(batch);
+            if (got.empty()) break;
+            for (Item& item : got) {
+                item.value = item.value * 2 + 1;
+                co_await out.push(item);
+            }
+        }
+    }
+    out.close();
+}
+
+ChannelTask consumer(AsyncListChannel<Item>& in, size_t batch, Result& result, std::latch& done) {
+    uint64_t acc = 0;
+    if (batch == 1) {
+        while (auto item = co_await in.pop()) {
+            acc += item->value;
+            result.latencies.push_back(nowNs() - item->producedNs);
+        }
+    } else {
+        for (;;) {
+            DoublyLinkedList<Item> got = co_await in.pop_n(batch);
+            if (got.empty()) break;
+            int64_t now = nowNs();
+            for (const Item& item : got) {
+                acc += item.value;
+                result.latencies.push_back(now - item.producedNs);
+            }
+        }
+    }
+    bench_do_not_optimize(acc);
+    done.count_down();
+}
+
+Result runPipeline(ChannelExecutor& ex, const Config& cfg, SingleThreadExecutor* drive) {
+    AsyncListChannel<Item> stage1(ex, cfg.capacity);
+    AsyncListChannel<Item> stage2(ex, cfg.capacity);
+    Result result;
+    result.latencies.reserve(cfg.items);
+    std::latch done(1);
+    BenchTimer timer;
+    spawn(ex, consumer(stage2, cfg.batch, result, done));
+    spawn(ex, transform(stage1, stage2, cfg.batch));
+    spawn(ex, producer(stage1, cfg.items));
+    if (drive) drive->run();
+    done.wait();
+    result.totalNs = timer.elapsed_ns();
+    return result;
+}
+
+// What the channel replaces: three threads spinning on empty() under a mutex.
+Result runBusyPoll(const Config& cfg) {
+    struct Queue {
+        std::mutex m;
+        DoublyLinkedList<Item> items;
+        bool closed = false;
+    } q1, q2;
+    Result result;
+    result.latencies.reserve(cfg.items);
+
+    auto pushBounded = [&](Queue& q, const Item& item) {
+        for (;; std::this_thread::yield()) {
+            std::lock_guard<std::mutex> lock(q.m);
+            if (q.items.size() < cfg.capacity) {
+                q.items.push_back(item);
+                return;
+            }
+        }
+    };
+    auto popPolling = [&](Queue& q, Item& out) {
+        for (;; std::this_thread::yield()) {
+            std::lock_guard<std::mutex> lock(q.m);
+            if (!q.items.empty()) {
+                out = q.items.front();
+                q.items.pop_front();
+                return true;
+            }
+            if (q.closed) return false;
+        }
+    };
+
+    BenchTimer timer;
+    std::thread prod([&] {
+        for (size_t i = 0; i < cfg.items; ++i) pushBounded(q1, Item{i, nowNs()});
+        std::lock_guard<std::mutex> lock(q1.m);
+        q1.closed = true;
+    });
+    std::thread mid([&] {
+        Item item;
+        while (popPolling(q1, item)) {
+            item.value = item.value * 2 + 1;
+            pushBounded(q2, item);
+        }
+        std::lock_guard<std::mutex> lock(q2.m);
+        q2.closed = true;
+    });
+    uint64_t acc = 0;
+    Item item;
+    while (popPolling(q2, item)) {
+        acc += item.value;
+        result.latencies.push_back(nowNs() - item.producedNs);
+    }
+    prod.join();
+    mid.join();
+    bench_do_not_optimize(acc);
+    result.totalNs = timer.elapsed_ns();
+    return result;
+}
+
+void report(BenchReporter& rep, const char* variant, unsigned threads, const Config& cfg, Result& r) {
+    std::sort(r.latencies.begin(), r.latencies.end());
+    auto pct = [&](double p) {
+        if (r.latencies.empty()) return 0.0;
+        return static_cast<double>(r.latencies[static_cast<size_t>(p * (r.latencies.size() - 1))]);
+    };
+    rep.add("async_channel_pipeline")
+        .set("variant", variant)
+        .set("threads", static_cast<int>(threads))
+        .set("items", static_cast<uint64_t>(cfg.items))
+        .set("capacity", static_cast<uint64_t>(cfg.capacity))
+        .set("batch", static_cast<uint64_t>(cfg.batch))
+        .set("items_per_sec", static_cast<double>(cfg.items) * 1e9 / r.totalNs)
+        .set("latency_p50_ns", pct(0.50))
+        .set("latency_p99_ns", pct(0.99));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    size_t capacity = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 256;
+    size_t batch = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 32;
+    unsigned poolThreads = argc > 4 ? static_cast<unsigned>(std::strtoul(argv[4], nullptr, 10))
+                                    : std::max(2u, std::thread::hardware_concurrency());
+    capacity = std::max<size_t>(1, capacity);
+    batch = std::max<size_t>(1, batch);
+
+    BenchReporter rep;
+    for (size_t b : {size_t(1), batch}) {
+        Config cfg{items, capacity, b};
+        {
+            SingleThreadExecutor ex;
+            Result r = runPipeline(ex, cfg, &ex);
+            report(rep, "single_thread", 1, cfg, r);
+        }
+        {
+            ThreadPoolExecutor ex(poolThreads);
+            Result r = runPipeline(ex, cfg, nullptr);
+            report(rep, "thread_pool", poolThreads, cfg, r);
+        }
+    }
+    Config baseline{items, capacity, 1};
+    Result r = runBusyPoll(baseline);
+    report(rep, "busy_poll_mutex", 3, baseline, r);
+    rep.print();
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Bulk removal on large lists: clear(), erase(first, last) over the middle
+// half, remove_all() of every third value, erase_if() of the odd values and
+// unique() over runs of equal pairs. DoublyLinkedList against std::list,
+// plus list_pmr::DoublyLinkedList on a monotonic arena for clear().
+//
+// usage: bench_bulk_erase [n]
+
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <memory_resource>
+
+#include "../DoublyLinkedList.h"
+#include "BenchHarness.h"
+
+namespace {
+
+template <typename List>
+void fill(List& list, size_t n, int (*value)(size_t)) {
+    for (size_t i = 0; i < n; ++i) list.push_back(value(i));
+}
+
+int identity(size_t i) { return static_cast<int>(i); }
+int mod3(size_t i) { return static_cast<int>(i % 3); }
+int pairs(size_t i) { return static_cast<int>(i / 2); }
+
+template <typename List>
+void run(const char* name, size_t n, BenchReporter& report) {
+    auto add = [&](const char* op, double ns, size_t removed) {
+        report.add("bulk_erase")
+            .set("container", name)
+            .set("op", op)
+            .set("n", static_cast<uint64_t>(n))
+            .set("removed", static_cast<uint64_t>(removed))
+            .set("ms", ns / 1e6)
+            .set("ns_per_removed", removed ? ns / static_cast<double>(removed) : 0.0);
+    };
+
+    {
+        List list;
+        fill(list, n, identity);
+        BenchTimer timer;
+        list.clear();
+        add("clear", timer.elapsed_ns(), n);
+    }
+    {
+        List list;
+        fill(list, n, identity);
+        auto first = list.begin();
+        std::advance(first, n / 4);
+        auto last = first;
+        std::advance(last, n / 2);
+        BenchTimer timer;
+        list.erase(first, last);
+        add("erase_range", timer.elapsed_ns(), n / 2);
+    }
+    {
+        List list;
+        fill(list, n, mod3);
+        BenchTimer timer;
+        size_t before = list.size();
+        if constexpr (std::is_same<List, std::list<int>>::value) list.remove(0);
+        else list.remove_all(0);
+        add("remove_all", timer.elapsed_ns(), before - list.size());
+    }
+    {
+        List list;
+        fill(list, n, identity);
+        BenchTimer timer;
+        size_t before = list.size();
+        if constexpr (std::is_same<List, std::list<int>>::value) list.remove_if([](int v) { return v & 1; });
+        else list.erase_if([](int v) { return v & 1; });
+        add("erase_if", timer.elapsed_ns(), before - list.size());
+    }
+    {
+        List list;
+        fill(list, n, pairs);
+        BenchTimer timer;
+        size_t before = list.size();
+        list.unique();
+        add("unique", timer.elapsed_ns(), before - list.size());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    BenchReporter report;
+    run<DoublyLinkedList<int>>("DoublyLinkedList", n, report);
+    run<std::list<int>>("std::list", n, report);
+
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        list_pmr::DoublyLinkedList<int> list(&arena);
+        fill(list, n, identity);
+        BenchTimer timer;
+        list.clear();
+        report.add("bulk_erase")
+            .set("container", "list_pmr::DoublyLinkedList/monotonic")
+            .set("op", "clear")
+            .set("n", static_cast<uint64_t>(n))
+            .set("removed", static_cast<uint64_t>(n))
+            .set("ms", timer.elapsed_ns() / 1e6)
+            .set("ns_per_removed", n ? timer.elapsed_ns() / static_cast<double>(n) : 0.0);
+    }
+    report.print();
+    return 0;
+}
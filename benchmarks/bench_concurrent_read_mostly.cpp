@@ -0,0 +1,133 @@
+// 99% read / 1% write mix over a shared list, comparing the epoch-based
+// ConcurrentDoublyLinkedList with a DoublyLinkedList behind a mutex and
+// behind a shared_mutex.
+//
+// usage: bench_concurrent_read_mostly [list_size] [ops_per_thread] [max_threads]
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "../ConcurrentDoublyLinkedList.h"
+#include "../DoublyLinkedList.h"
+#include "BenchHarness.h"
+
+namespace {
+
+constexpr int kWritePercent = 1;
+
+struct Workload {
+    size_t listSize;
+    size_t opsPerThread;
+    unsigned threads;
+};
+
+template <typename ReadFn, typename WriteFn>
+double runThreads(const Workload& w, ReadFn read, WriteFn write) {
+    std::vector<std::thread> pool;
+    BenchTimer timer;
+    for (unsigned t = 0; t < w.threads; ++t) {
+        pool.emplace_back([&, t] {
+            std::mt19937 rng(1234 + t);
+            std::uniform_int_distribution<int> pct(0, 99);
+            long long acc = 0;
+            for (size_t i = 0; i < w.opsPerThread; ++i) {
+                if (pct(rng) < kWritePercent) write(static_cast<int>(i));
+                else acc += read();
+            }
+            bench_do_not_optimize(acc);
+        });
+    }
+    for (auto& th : pool) th.join();
+    return timer.elapsed_ns();
+}
+
+double benchEpoch(const Workload& w) {
+    ConcurrentDoublyLinkedList<int> list;
+    for (size_t i = 0; i < w.listSize; ++i) list.push_back(static_cast<int>(i));
+    return runThreads(
+        w,
+        [&] {
+            long long s = 0;
+            list.for_each([&](int v) { s += v; });
+            return s;
+        },
+        [&](int v) {
+            list.push_back(v);
+            list.pop_front();
+        });
+}
+
+double benchMutex(const Workload& w) {
+    DoublyLinkedList<int> list;
+    std::mutex m;
+    for (size_t i = 0; i < w.listSize; ++i) list.push_back(static_cast<int>(i));
+    return runThreads(
+        w,
+        [&] {
+            std::lock_guard<std::mutex> lock(m);
+            long long s = 0;
+            for (int v : list) s += v;
+            return s;
+        },
+        [&](int v) {
+            std::lock_guard<std::mutex> lock(m);
+            list.push_back(v);
+            list.pop_front();
+        });
+}
+
+double benchSharedMutex(const Workload& w) {
+    DoublyLinkedList<int> list;
+    std::shared_mutex m;
+    for (size_t i = 0; i < w.listSize; ++i) list.push_back(static_cast<int>(i));
+    return runThreads(
+        w,
+        [&] {
+            std::shared_lock<std::shared_mutex> lock(m);
+            long long s = 0;
+            for (int v : list) s += v;
+            return s;
+        },
+        [&](int v) {
+            std::unique_lock<std::shared_mutex> lock(m);
+            list.push_back(v);
+            list.pop_front();
+        });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t listSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+    size_t ops = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+    unsigned hw = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10))
+                           : std::max(1u, std::thread::hardware_concurrency());
+
+    BenchReporter report;
+    for (unsigned threads = 1; threads <= hw; threads *= 2) {
+        Workload w{listSize, ops, threads};
+        double total = static_cast<double>(ops) * threads;
+        struct { const char* name; double (*fn)(const Workload&); } variants[] = {
+            {"epoch", benchEpoch},
+            {"mutex", benchMutex},
+            {"shared_mutex", benchSharedMutex},
+        };
+        for (const auto& v : variants) {
+            double ns = v.fn(w);
+            report.add("concurrent_read_mostly")
+                .set("variant", v.name)
+                .set("threads", static_cast<int>(threads))
+                .set("list_size", static_cast<uint64_t>(listSize))
+                .set("write_percent", kWritePercent)
+                .set("ops_per_sec", total * 1e9 / ns);
+        }
+    }
+    EpochDomain::global().reclaim();
+    report.print();
+    return 0;
+}
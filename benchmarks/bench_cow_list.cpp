@@ -0,0 +1,87 @@
+// Pass-by-value-heavy code on DoublyLinkedList against CowDoublyLinkedList:
+// each call hands an n-element list down a chain of `depth` functions that
+// take it by value and read it, and every mutate_every-th call appends to
+// its copy on the way (0 = never, 1 = every call). Also times one copy of
+// the list with the bulk copy constructor against a push_back loop.
+//
+// usage: bench_cow_list [n] [calls] [depth]
+
+#include <cstdlib>
+
+#include "../CowDoublyLinkedList.h"
+#include "../DoublyLinkedList.h"
+#include "BenchHarness.h"
+
+namespace {
+
+template <typename List>
+List stage(List list, size_t depth, size_t call, size_t mutateEvery, long long& acc) {
+    const List& view = list;
+    acc += static_cast<long long>(view.size()) + view.front() + view.back();
+    if (mutateEvery && call % mutateEvery == 0) list.push_back(static_cast<int>(call));
+    if (depth == 0) return list;
+    return stage(list, depth - 1, call, mutateEvery, acc);
+}
+
+template <typename List>
+double runCalls(const List& base, size_t calls, size_t depth, size_t mutateEvery, long long& acc) {
+    BenchTimer timer;
+    for (size_t call = 0; call < calls; ++call) {
+        List result = stage(base, depth, call, mutateEvery, acc);
+        acc += static_cast<long long>(result.size());
+    }
+    return timer.elapsed_ns();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+    size_t calls = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+    size_t depth = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 4;
+    if (n == 0) n = 1;
+
+    DoublyLinkedList<int> plain;
+    for (size_t i = 0; i < n; ++i) plain.push_back(static_cast<int>(i));
+    CowDoublyLinkedList<int> shared(plain);
+
+    BenchReporter report;
+    long long acc = 0;
+
+    for (size_t mutateEvery : {size_t(0), size_t(16), size_t(1)}) {
+        double plainNs = runCalls(plain, calls, depth, mutateEvery, acc);
+        double cowNs = runCalls(shared, calls, depth, mutateEvery, acc);
+        for (int cow = 0; cow < 2; ++cow) {
+            report.add("cow_list")
+                .set("op", "pass_by_value")
+                .set("container", cow ? "CowDoublyLinkedList" : "DoublyLinkedList")
+                .set("n", static_cast<uint64_t>(n))
+                .set("depth", static_cast<uint64_t>(depth))
+                .set("mutate_every", static_cast<uint64_t>(mutateEvery))
+                .set("ns_per_call", (cow ? cowNs : plainNs) / static_cast<double>(calls));
+        }
+    }
+
+    size_t copies = calls / 10 + 1;
+    BenchTimer timer;
+    for (size_t i = 0; i < copies; ++i) {
+        DoublyLinkedList<int> copy(plain);
+        acc += static_cast<long long>(copy.size());
+    }
+    double bulkNs = timer.elapsed_ns();
+    timer.reset();
+    for (size_t i = 0; i < copies; ++i) {
+        DoublyLinkedList<int> copy;
+        for (int v : plain) copy.push_back(v);
+        acc += static_cast<long long>(copy.size());
+    }
+    double loopNs = timer.elapsed_ns();
+    report.add("cow_list").set("op", "copy").set("container", "bulk_copy").set("n", static_cast<uint64_t>(n))
+        .set("ns_per_call", bulkNs / static_cast<double>(copies));
+    report.add("cow_list").set("op", "copy").set("container", "push_back_loop").set("n", static_cast<uint64_t>(n))
+        .set("ns_per_call", loopNs / static_cast<double>(copies));
+
+    bench_do_not_optimize(acc);
+    report.print();
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Access by id on a DoublyLinkedList: get(Handle) against at(index) (finger
+// walk) and find_first_index + at, for random ids; then erase(Handle)
+// against erase_at(index) for random elements, and emplace() of a
+// two-field element against push_back of a built one.
+//
+// usage: bench_handles [n] [lookups]
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../DoublyLinkedList.h"
+#include "BenchHarness.h"
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000;
+    if (n == 0) n = 1;
+
+    DoublyLinkedList<int> list;
+    std::vector<DoublyLinkedList<int>::Handle> handles;
+    handles.reserve(n);
+    for (size_t i = 0; i < n; ++i) handles.push_back(list.insert(list.cend(), static_cast<int>(i)));
+
+    std::mt19937 rng(7);
+    std::vector<size_t> ids(lookups);
+    for (auto& id : ids) id = rng() % n;
+
+    BenchReporter report;
+    auto add = [&](const char* op, double ns, size_t ops) {
+        report.add("handles")
+            .set("op", op)
+            .set("n", static_cast<uint64_t>(n))
+            .set("ns_per_op", ops ? ns / static_cast<double>(ops) : 0.0);
+    };
+
+    long long acc = 0;
+    BenchTimer timer;
+    for (size_t id : ids) acc += *list.get(handles[id]);
+    add("get_handle", timer.elapsed_ns(), lookups);
+
+    const DoublyLinkedList<int>& clist = list;
+    timer.reset();
+    for (size_t id : ids) acc += clist.at(id);
+    add("at_index", timer.elapsed_ns(), lookups);
+
+    size_t searches = lookups / 10 + 1;
+    timer.reset();
+    for (size_t i = 0; i < searches; ++i) acc += clist.at(clist.find_first_index(static_cast<int>(ids[i])));
+    add("find_first_index_at", timer.elapsed_ns(), searches);
+    bench_do_not_optimize(acc);
+
+    // Erase in a random order, by handle and by (current) index.
+    size_t erases = std::min(lookups, n);
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+    timer.reset();
+    for (size_t i = 0; i < erases; ++i) list.erase(handles[order[i]]);
+    add("erase_handle", timer.elapsed_ns(), erases);
+
+    DoublyLinkedList<int> byIndex;
+    for (size_t i = 0; i < n; ++i) byIndex.push_back(static_cast<int>(i));
+    timer.reset();
+    for (size_t i = 0; i < erases; ++i) byIndex.erase_at(rng() % byIndex.size());
+    add("erase_at_index", timer.elapsed_ns(), erases);
+
+    DoublyLinkedList<std::pair<int, int>> pairs;
+    timer.reset();
+    for (size_t i = 0; i < n; ++i) pairs.emplace(pairs.cend(), static_cast<int>(i), static_cast<int>(i) * 2);
+    add("emplace_handle", timer.elapsed_ns(), n);
+
+    DoublyLinkedList<std::pair<int, int>> pushed;
+    timer.reset();
+    for (size_t i = 0; i < n; ++i) pushed.push_back(std::make_pair(static_cast<int>(i), static_cast<int>(i) * 2));
+    add("push_back_pair", timer.elapsed_ns(), n);
+    if (pairs != pushed) {
+        std::cerr << "bench_handles: emplaced and pushed lists differ\n";
+        return 1;
+    }
+
+    report.print();
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Alternating reverse() and push/pop workloads: DoublyLinkedList with its
+// O(1) direction-bit reverse, the same list forced back to physical order
+// after every reverse (the old O(n) behaviour), and std::list.
+//
+// usage: bench_lazy_reverse [n] [rounds]
+
+#include <cstdlib>
+#include <list>
+#include <string>
+
+#include "../DoublyLinkedList.h"
+#include "BenchHarness.h"
+
+namespace {
+
+struct LazyDll {
+    DoublyLinkedList<int> list;
+    static constexpr const char* name = "DoublyLinkedList";
+    void reverse() { list.reverse(); }
+};
+
+struct EagerDll {
+    DoublyLinkedList<int> list;
+    static constexpr const char* name = "DoublyLinkedList+normalize";
+    void reverse() {
+        list.reverse();
+        list.normalize();
+    }
+};
+
+struct StdList {
+    std::list<int> list;
+    static constexpr const char* name = "std::list";
+    void reverse() { list.reverse(); }
+};
+
+template <typename C>
+void run(size_t n, size_t rounds, BenchReporter& report) {
+    auto add = [&](const char* op, double ns, size_t ops) {
+        report.add("lazy_reverse")
+            .set("container", C::name)
+            .set("op", op)
+            .set("n", static_cast<uint64_t>(n))
+            .set("ns_per_op", ns / static_cast<double>(ops));
+    };
+
+    C c;
+    for (size_t i = 0; i < n; ++i) c.list.push_back(static_cast<int>(i));
+
+    // reverse, then push at both ends.
+    BenchTimer timer;
+    for (size_t r = 0; r < rounds; ++r) {
+        c.reverse();
+        c.list.push_back(static_cast<int>(r));
+        c.list.push_front(static_cast<int>(r));
+    }
+    add("reverse_push", timer.elapsed_ns(), rounds);
+
+    // Sliding window: reverse, read a few elements from the new front,
+    // drop one from each end and refill.
+    timer.reset();
+    long long acc = 0;
+    for (size_t r = 0; r < rounds; ++r) {
+        c.reverse();
+        auto it = c.list.begin();
+        for (int k = 0; k < 8; ++k, ++it) acc += *it;
+        c.list.pop_front();
+        c.list.pop_back();
+        c.list.push_back(static_cast<int>(r));
+        c.list.push_front(static_cast<int>(r));
+    }
+    bench_do_not_optimize(acc);
+    add("reverse_window", timer.elapsed_ns(), rounds);
+
+    // Full traversal, to show what the direction check costs per step.
+    timer.reset();
+    acc = 0;
+    for (int v : c.list) acc += v;
+    bench_do_not_optimize(acc);
+    add("iterate", timer.elapsed_ns(), c.list.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    size_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000;
+    if (rounds == 0) rounds = 1;
+
+    BenchReporter report;
+    run<LazyDll>(n, rounds, report);
+    run<EagerDll>(n, rounds, report);
+    run<StdList>(n, rounds, report);
+    report.print();
+    return 0;
+}
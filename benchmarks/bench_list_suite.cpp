@@ -0,0 +1,385 @@
+// Operation-by-operation comparison of the repo's lists with the standard
+// sequence containers. Every (operation, container, size) cell becomes one
+// JSON record with the mean time per operation.
+//
+// at_sequential reads c[0], c[1], ... in order, the legacy index-loop pattern.
+//
+// usage: bench_list_suite [--min-size N] [--max-size N] [--quadratic-max N]
+//                         [--budget-ms N] [--out FILE]
+//
+// Sizes run over powers of ten from --min-size (default 1e2) to --max-size
+// (default 1e7). Per-element operations (push, pop, at, insert_at) run up to
+// 100000 times per cell but stop early once --budget-ms is spent, so O(n)
+// per-call operations on large sizes report an average over fewer calls.
+// Whole-container operations whose cost is quadratic for a given container
+// are skipped above --quadratic-max elements.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <forward_list>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../DoublyLinkedList.h"
+#include "../IndexedLinkedList.h"
+#include "../SinglyLinkedList.h"
+#include "BenchHarness.h"
+
+namespace {
+
+struct Options {
+    size_t minSize = 100;
+    size_t maxSize = 10000000;
+    size_t quadraticMax = 20000;
+    double budgetNs = 200e6;
+    std::string out;
+};
+
+std::vector<int> makeValues(size_t n, uint32_t seed, int range) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, range);
+    std::vector<int> v(n);
+    for (auto& x : v) x = dist(rng);
+    return v;
+}
+
+// ---------------------------------------------------------------------------
+// Adapters. Each one exposes the operations its container supports; the
+// `has` flags tell the driver which cells to run.
+
+enum Op : unsigned {
+    kPushBack = 1u << 0,
+    kPushFront = 1u << 1,
+    kPopFront = 1u << 2,
+    kPopBack = 1u << 3,
+    kAt = 1u << 4,
+    kInsertAt = 1u << 5,
+    kSort = 1u << 6,
+    kRemoveDuplicates = 1u << 7,
+    kReverse = 1u << 8,
+    kMerge = 1u << 9,
+    kIterate = 1u << 10,
+};
+
+// Containers whose remove_duplicates is O(n^2).
+constexpr unsigned kQuadraticDedupe = 1u << 16;
+
+struct SllAdapter {
+    using C = SinglyLinkedList;
+    static constexpr const char* name = "SinglyLinkedList";
+    static constexpr unsigned has = kPushBack | kPushFront | kPopFront | kPopBack | kInsertAt | kReverse;
+    static void build(C& c, const std::vector<int>& v) { for (int x : v) c.push_back(x); }
+    static void push_back(C& c, int v) { c.push_back(v); }
+    static void push_front(C& c, int v) { c.push_front(v); }
+    static void pop_front(C& c) { c.pop_front(); }
+    static void pop_back(C& c) { c.pop_back(); }
+    static void insert_at(C& c, size_t i, int v) { c.insert_at(i, v); }
+    static void reverse(C& c) { c.reverse(); }
+    static int at(C&, size_t) { return 0; }
+    static void sort(C&) {}
+    static void remove_duplicates(C&) {}
+    static void merge(C&, C&) {}
+    static long long iterate(const C&) { return 0; }
+};
+
+struct DllAdapter {
+    using C = DoublyLinkedList<int>;
+    static constexpr const char* name = "DoublyLinkedList";
+    static constexpr unsigned has = kPushBack | kPushFront | kPopFront | kPopBack | kAt | kInsertAt | kSort |
+                                    kRemoveDuplicates | kReverse | kMerge | kIterate | kQuadraticDedupe;
+    static void build(C& c, const std::vector<int>& v) { for (int x : v) c.push_back(x); }
+    static void push_back(C& c, int v) { c.push_back(v); }
+    static void push_front(C& c, int v) { c.push_front(v); }
+    static void pop_front(C& c) { c.pop_front(); }
+    static void pop_back(C& c) { c.pop_back(); }
+    static int at(C& c, size_t i) { return c.at(i); }
+    static void insert_at(C& c, size_t i, int v) { c.insert_at(i, v); }
+    static void sort(C& c) { c.sort_ascending(); }
+    static void remove_duplicates(C& c) { c.remove_duplicates(); }
+    static void reverse(C& c) { c.reverse(); }
+    static void merge(C& a, C& b) { a.merge(b); }
+    static long long iterate(const C& c) {
+        long long s = 0;
+        for (int x : c) s += x;
+        return s;
+    }
+};
+
+struct IndexedAdapter {
+    using C = IndexedLinkedList<int>;
+    static constexpr const char* name = "IndexedLinkedList";
+    static constexpr unsigned has = kPushBack | kPushFront | kPopFront | kPopBack | kAt | kInsertAt | kReverse | kIterate;
+    static void build(C& c, const std::vector<int>& v) { for (int x : v) c.push_back(x); }
+    static void push_back(C& c, int v) { c.push_back(v); }
+    static void push_front(C& c, int v) { c.push_front(v); }
+    static void pop_front(C& c) { c.pop_front(); }
+    static void pop_back(C& c) { c.pop_back(); }
+    static int at(C& c, size_t i) { return c.at(i); }
+    static void insert_at(C& c, size_t i, int v) { c.insert_at(i, v); }
+    static void sort(C&) {}
+    static void remove_duplicates(C&) {}
+    static void reverse(C& c) { c.reverse(); }
+    static void merge(C&, C&) {}
+    static long long iterate(const C& c) {
+        long long s = 0;
+        for (int x : c) s += x;
+        return s;
+    }
+};
+
+// Order-preserving duplicate removal, the std-container equivalent of
+// DoublyLinkedList::remove_duplicates().
+template <typename C>
+void stableDedupe(C& c) {
+    std::unordered_set<int> seen;
+    seen.reserve(c.size());
+    c.erase(std::remove_if(c.begin(), c.end(), [&](int x) { return !seen.insert(x).second; }), c.end());
+}
+
+struct ListAdapter {
+    using C = std::list<int>;
+    static constexpr const char* name = "std::list";
+    static constexpr unsigned has = kPushBack | kPushFront | kPopFront | kPopBack | kAt | kInsertAt | kSort |
+                                    kRemoveDuplicates | kReverse | kMerge | kIterate;
+    static void build(C& c, const std::vector<int>& v) { c.assign(v.begin(), v.end()); }
+    static void push_back(C& c, int v) { c.push_back(v); }
+    static void push_front(C& c, int v) { c.push_front(v); }
+    static void pop_front(C& c) { c.pop_front(); }
+    static void pop_back(C& c) { c.pop_back(); }
+    static int at(C& c, size_t i) { return *std::next(c.begin(), static_cast<long>(i)); }
+    static void insert_at(C& c, size_t i, int v) { c.insert(std::next(c.begin(), static_cast<long>(i)), v); }
+    static void sort(C& c) { c.sort(); }
+    static void remove_duplicates(C& c) {
+        std::unordered_set<int> seen;
+        seen.reserve(c.size());
+        c.remove_if([&](int x) { return !seen.insert(x).second; });
+    }
+    static void reverse(C& c) { c.reverse(); }
+    static void merge(C& a, C& b) { a.merge(b); }
+    static long long iterate(const C& c) {
+        long long s = 0;
+        for (int x : c) s += x;
+        return s;
+    }
+};
+
+struct ForwardListAdapter {
+    using C = std::forward_list<int>;
+    static constexpr const char* name = "std::forward_list";
+    static constexpr unsigned has = kPushFront | kPopFront | kAt | kInsertAt | kSort | kRemoveDuplicates |
+                                    kReverse | kMerge | kIterate;
+    static void build(C& c, const std::vector<int>& v) { c.assign(v.begin(), v.end()); }
+    static void push_back(C&, int) {}
+    static void push_front(C& c, int v) { c.push_front(v); }
+    static void pop_front(C& c) { c.pop_front(); }
+    static void pop_back(C&) {}
+    static int at(C& c, size_t i) { return *std::next(c.begin(), static_cast<long>(i)); }
+    static void insert_at(C& c, size_t i, int v) { c.insert_after(std::next(c.before_begin(), static_cast<long>(i)), v); }
+    static void sort(C& c) { c.sort(); }
+    static void remove_duplicates(C& c) {
+        std::unordered_set<int> seen;
+        c.remove_if([&](int x) { return !seen.insert(x).second; });
+    }
+    static void reverse(C& c) { c.reverse(); }
+    static void merge(C& a, C& b) { a.merge(b); }
+    static long long iterate(const C& c) {
+        long long s = 0;
+        for (int x : c) s += x;
+        return s;
+    }
+};
+
+template <typename Seq, const char* Name>
+struct RandomAccessAdapter {
+    using C = Seq;
+    static constexpr const char* name = Name;
+    static constexpr unsigned has = kPushBack | kPushFront | kPopFront | kPopBack | kAt | kInsertAt | kSort |
+                                    kRemoveDuplicates | kReverse | kMerge | kIterate;
+    static void build(C& c, const std::vector<int>& v) { c.assign(v.begin(), v.end()); }
+    static void push_back(C& c, int v) { c.push_back(v); }
+    static void push_front(C& c, int v) { c.insert(c.begin(), v); }
+    static void pop_front(C& c) { c.erase(c.begin()); }
+    static void pop_back(C& c) { c.pop_back(); }
+    static int at(C& c, size_t i) { return c[i]; }
+    static void insert_at(C& c, size_t i, int v) { c.insert(c.begin() + static_cast<long>(i), v); }
+    static void sort(C& c) { std::sort(c.begin(), c.end()); }
+    static void remove_duplicates(C& c) { stableDedupe(c); }
+    static void reverse(C& c) { std::reverse(c.begin(), c.end()); }
+    static void merge(C& a, C& b) {
+        auto mid = static_cast<long>(a.size());
+        a.insert(a.end(), b.begin(), b.end());
+        b.clear();
+        std::inplace_merge(a.begin(), a.begin() + mid, a.end());
+    }
+    static long long iterate(const C& c) {
+        long long s = 0;
+        for (int x : c) s += x;
+        return s;
+    }
+};
+
+constexpr char kVectorName[] = "std::vector";
+constexpr char kDequeName[] = "std::deque";
+using VectorAdapter = RandomAccessAdapter<std::vector<int>, kVectorName>;
+using DequeAdapter = RandomAccessAdapter<std::deque<int>, kDequeName>;
+
+// ---------------------------------------------------------------------------
+// Driver
+
+class Suite {
+public:
+    Suite(const Options& o, BenchReporter& r) : opts(o), report(r) {}
+
+    template <typename A>
+    void run(size_t n) {
+        std::vector<int> values = makeValues(n, 42, static_cast<int>(n));
+        size_t maxCalls = std::min<size_t>(n, 100000);
+
+        if (A::has & kPushBack) {
+            perCall<A>("push_back", n, values, maxCalls, [](typename A::C& c, size_t i) {
+                A::push_back(c, static_cast<int>(i));
+            });
+        }
+        if (A::has & kPushFront) {
+            perCall<A>("push_front", n, values, maxCalls, [](typename A::C& c, size_t i) {
+                A::push_front(c, static_cast<int>(i));
+            });
+        }
+        if (A::has & kPopFront) {
+            perCall<A>("pop_front", n, values, maxCalls, [](typename A::C& c, size_t) { A::pop_front(c); });
+        }
+        if (A::has & kPopBack) {
+            perCall<A>("pop_back", n, values, maxCalls, [](typename A::C& c, size_t) { A::pop_back(c); });
+        }
+        if (A::has & kAt) {
+            std::vector<int> idx = makeValues(maxCalls, 7, static_cast<int>(n - 1));
+            perCall<A>("at", n, values, maxCalls, [&](typename A::C& c, size_t i) {
+                bench_do_not_optimize(A::at(c, static_cast<size_t>(idx[i])));
+            });
+            perCall<A>("at_sequential", n, values, maxCalls, [](typename A::C& c, size_t i) {
+                bench_do_not_optimize(A::at(c, i));
+            });
+        }
+        if (A::has & kInsertAt) {
+            perCall<A>("insert_at", n, values, maxCalls, [n](typename A::C& c, size_t i) {
+                A::insert_at(c, n / 2, static_cast<int>(i));
+            });
+        }
+        if (A::has & kSort) {
+            whole<A>("sort", n, values, [](typename A::C& c) { A::sort(c); });
+        }
+        if ((A::has & kRemoveDuplicates) && (!(A::has & kQuadraticDedupe) || n <= opts.quadraticMax)) {
+            std::vector<int> dupes = makeValues(n, 43, static_cast<int>(n / 4));
+            whole<A>("remove_duplicates", n, dupes, [](typename A::C& c) { A::remove_duplicates(c); });
+        }
+        if (A::has & kReverse) {
+            whole<A>("reverse", n, values, [](typename A::C& c) { A::reverse(c); });
+        }
+        if (A::has & kIterate) {
+            whole<A>("iterate", n, values, [](typename A::C& c) { bench_do_not_optimize(A::iterate(c)); });
+        }
+        if (A::has & kMerge) {
+            std::vector<int> left(values.begin(), values.begin() + static_cast<long>(n / 2));
+            std::vector<int> right(values.begin() + static_cast<long>(n / 2), values.end());
+            std::sort(left.begin(), left.end());
+            std::sort(right.begin(), right.end());
+            typename A::C a, b;
+            A::build(a, left);
+            A::build(b, right);
+            BenchTimer timer;
+            A::merge(a, b);
+            record<A>("merge", n, 1, timer.elapsed_ns());
+        }
+    }
+
+private:
+    template <typename A, typename F>
+    void perCall(const char* op, size_t n, const std::vector<int>& values, size_t maxCalls, F f) {
+        typename A::C c;
+        A::build(c, values);
+        BenchTimer timer;
+        size_t calls = 0;
+        while (calls < maxCalls) {
+            f(c, calls);
+            ++calls;
+            if ((calls & 15) == 0 && timer.elapsed_ns() > opts.budgetNs) break;
+        }
+        record<A>(op, n, calls, timer.elapsed_ns());
+    }
+
+    template <typename A, typename F>
+    void whole(const char* op, size_t n, const std::vector<int>& values, F f) {
+        typename A::C c;
+        A::build(c, values);
+        BenchTimer timer;
+        f(c);
+        record<A>(op, n, 1, timer.elapsed_ns());
+    }
+
+    template <typename A>
+    void record(const char* op, size_t n, size_t calls, double ns) {
+        report.add("list_suite")
+            .set("op", op)
+            .set("container", A::name)
+            .set("size", static_cast<uint64_t>(n))
+            .set("calls", static_cast<uint64_t>(calls))
+            .set("ns_per_op", ns / static_cast<double>(calls));
+    }
+
+    const Options& opts;
+    BenchReporter& report;
+};
+
+bool parseArgs(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        auto next = [&](const char* flag) -> const char* {
+            if (std::strcmp(argv[i], flag) != 0 || i + 1 >= argc) return nullptr;
+            return argv[++i];
+        };
+        if (const char* v = next("--min-size")) o.minSize = std::strtoull(v, nullptr, 10);
+        else if (const char* v = next("--max-size")) o.maxSize = std::strtoull(v, nullptr, 10);
+        else if (const char* v = next("--quadratic-max")) o.quadraticMax = std::strtoull(v, nullptr, 10);
+        else if (const char* v = next("--budget-ms")) o.budgetNs = std::strtod(v, nullptr) * 1e6;
+        else if (const char* v = next("--out")) o.out = v;
+        else {
+            std::cerr << "unknown argument: " << argv[i] << "\n";
+            return false;
+        }
+    }
+    return o.minSize > 0 && o.minSize <= o.maxSize;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) return 2;
+
+    BenchReporter report;
+    Suite suite(opts, report);
+    for (size_t n = opts.minSize; n <= opts.maxSize; n *= 10) {
+        suite.run<SllAdapter>(n);
+        suite.run<DllAdapter>(n);
+        suite.run<IndexedAdapter>(n);
+        suite.run<ListAdapter>(n);
+        suite.run<ForwardListAdapter>(n);
+        suite.run<DequeAdapter>(n);
+        suite.run<VectorAdapter>(n);
+        std::cerr << "done n=" << n << "\n";
+    }
+
+    if (opts.out.empty()) {
+        report.print();
+    } else {
+        std::ofstream file(opts.out);
+        report.print(file);
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Bytes per element (from memory_usage()) and build / traversal time for
+// the int lists, including the arena-backed CompactList and the
+// delta-packed PackedSortedList.
+//
+// usage: bench_memory_footprint [n] [max_gap]
+//   max_gap bounds the distance between consecutive sorted keys fed to
+//   PackedSortedList (1 = dense ids).
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../CompactList.h"
+#include "../DoublyLinkedList.h"
+#include "../IndexedLinkedList.h"
+#include "../SinglyLinkedList.h"
+#include "BenchHarness.h"
+
+namespace {
+
+template <typename List>
+long long walk(const List& list) {
+    long long acc = 0;
+    for (auto v : list) acc += v;
+    return acc;
+}
+
+// SinglyLinkedList has no iterators; a failed search walks every node.
+long long walk(const SinglyLinkedList& list) {
+    return list.contains(-1);
+}
+
+template <typename List, typename Fill>
+void measure(const char* name, size_t n, BenchReporter& report, Fill fill) {
+    List list;
+    BenchTimer timer;
+    fill(list);
+    double buildNs = timer.elapsed_ns();
+
+    timer.reset();
+    long long acc = walk(list);
+    double walkNs = timer.elapsed_ns();
+    bench_do_not_optimize(acc);
+
+    ListMemoryUsage m = list.memory_usage();
+    report.add("memory_footprint")
+        .set("container", name)
+        .set("n", static_cast<uint64_t>(n))
+        .set("bytes_per_element", static_cast<double>(m.total_bytes()) / static_cast<double>(n))
+        .set("live_bytes", static_cast<uint64_t>(m.live_bytes))
+        .set("slack_bytes", static_cast<uint64_t>(m.slack_bytes))
+        .set("overhead_bytes", static_cast<uint64_t>(m.overhead_bytes))
+        .set("build_ns_per_element", buildNs / static_cast<double>(n))
+        .set("walk_ns_per_element", walkNs / static_cast<double>(n));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int maxGap = argc > 2 ? std::atoi(argv[2]) : 16;
+    if (n == 0) n = 1;
+    if (maxGap < 1) maxGap = 1;
+
+    std::vector<int> keys(n);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> gap(1, maxGap);
+    int key = 0;
+    for (size_t i = 0; i < n; ++i) keys[i] = key += gap(rng);
+
+    BenchReporter report;
+    measure<SinglyLinkedList>("SinglyLinkedList", n, report, [&](SinglyLinkedList& l) {
+        for (int k : keys) l.push_back(k);
+    });
+    measure<DoublyLinkedList<int>>("DoublyLinkedList", n, report, [&](DoublyLinkedList<int>& l) {
+        for (int k : keys) l.push_back(k);
+    });
+    measure<IndexedLinkedList<int>>("IndexedLinkedList", n, report, [&](IndexedLinkedList<int>& l) {
+        for (int k : keys) l.push_back(k);
+    });
+    measure<CompactList<int>>("CompactList", n, report, [&](CompactList<int>& l) {
+        for (int k : keys) l.push_back(k);
+    });
+    measure<CompactList<int>>("CompactList+shrink_to_fit", n, report, [&](CompactList<int>& l) {
+        for (int k : keys) l.push_back(k);
+        l.shrink_to_fit();
+    });
+    measure<PackedSortedList<int>>("PackedSortedList", n, report, [&](PackedSortedList<int>& l) {
+        for (int k : keys) l.push_back(k);
+    });
+    report.print();
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Scaling of parallel_for_each / parallel_reduce / parallel_transform /
+// parallel_filter with thread count, on a DoublyLinkedList (segmented by one
+// walk) and an IndexedLinkedList in slot order (segmented in O(p)). The
+// threads = 1 rows use the same calls with the cutoff raised so that they
+// run inline, and serve as the baseline for speedup.
+//
+// usage: bench_parallel_algorithms [n] [max_threads]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+
+#include "../DoublyLinkedList.h"
+#include "../IndexedLinkedList.h"
+#include "../ParallelListAlgorithms.h"
+#include "BenchHarness.h"
+
+namespace {
+
+// Enough arithmetic per element that the walk is not the only cost.
+inline double work(double x) {
+    return std::sqrt(x * 1.5 + 3.0) * 0.5 + std::sin(x);
+}
+
+template <typename List>
+void runOps(const char* containerName, List& list, unsigned threads, const ParallelOptions& opts,
+            std::map<std::string, double>& baseline, BenchReporter& report) {
+    auto record = [&](const char* op, double ns) {
+        std::string key = std::string(containerName) + "/" + op;
+        if (threads == 1) baseline[key] = ns;
+        report.add("parallel_algorithms")
+            .set("container", containerName)
+            .set("op", op)
+            .set("threads", static_cast<int>(threads))
+            .set("n", static_cast<uint64_t>(list.size()))
+            .set("ms", ns / 1e6)
+            .set("speedup", baseline[key] / ns);
+    };
+
+    BenchTimer timer;
+    parallel_for_each(list, [](double& x) { x = work(x); }, opts);
+    record("for_each", timer.elapsed_ns());
+
+    timer.reset();
+    double sum = parallel_reduce(list, 0.0, std::plus<double>(), [](double x) { return work(x); }, opts);
+    record("reduce", timer.elapsed_ns());
+    bench_do_not_optimize(sum);
+
+    timer.reset();
+    auto mapped = parallel_transform(list, [](double x) { return work(x); }, opts);
+    record("transform", timer.elapsed_ns());
+    bench_do_not_optimize(mapped.size());
+
+    timer.reset();
+    auto kept = parallel_filter(list, [](double x) { return work(x) > 1.0; }, opts);
+    record("filter", timer.elapsed_ns());
+    bench_do_not_optimize(kept.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10))
+                                   : std::max(1u, std::thread::hardware_concurrency());
+
+    DoublyLinkedList<double> dll;
+    IndexedLinkedList<double> indexed;
+    indexed.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        dll.push_back(static_cast<double>(i % 1000));
+        indexed.push_back(static_cast<double>(i % 1000));
+    }
+
+    BenchReporter report;
+    std::map<std::string, double> baseline;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        // The calling thread works too, so the pool needs threads - 1 workers.
+        WorkStealingPool pool(threads > 1 ? threads - 1 : 1);
+        ParallelOptions opts;
+        opts.pool = &pool;
+        if (threads == 1) opts.sequential_cutoff = n + 1;
+        runOps("DoublyLinkedList", dll, threads, opts, baseline, report);
+        runOps("IndexedLinkedList", indexed, threads, opts, baseline, report);
+    }
+    report.print();
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Request-scoped lists: each "request" builds a handful of temporary lists,
+// reads them and drops them. DoublyLinkedList on the default allocator
+// against list_pmr::DoublyLinkedList on a monotonic arena that is released
+// once per request (whose destructor skips the per-node walk for int), with
+// std::pmr::list on the same arena for reference.
+//
+// usage: bench_pmr_request [requests] [lists_per_request] [list_size]
+
+#include <cstdlib>
+#include <list>
+#include <memory_resource>
+#include <vector>
+
+#include "../DoublyLinkedList.h"
+#include "BenchHarness.h"
+
+namespace {
+
+template <typename List, typename MakeList>
+long long handleRequest(size_t lists, size_t len, MakeList make) {
+    long long acc = 0;
+    std::vector<List> temps;
+    temps.reserve(lists);
+    for (size_t l = 0; l < lists; ++l) {
+        temps.push_back(make());
+        List& list = temps.back();
+        for (size_t i = 0; i < len; ++i) list.push_back(static_cast<int>(i ^ l));
+        for (int v : list) acc += v;
+    }
+    return acc;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t requests = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+    size_t lists = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+    size_t len = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 256;
+    if (requests == 0) requests = 1;
+
+    BenchReporter report;
+    auto add = [&](const char* container, double ns) {
+        report.add("pmr_request")
+            .set("container", container)
+            .set("requests", static_cast<uint64_t>(requests))
+            .set("lists_per_request", static_cast<uint64_t>(lists))
+            .set("list_size", static_cast<uint64_t>(len))
+            .set("ns_per_request", ns / static_cast<double>(requests));
+    };
+
+    long long acc = 0;
+    BenchTimer timer;
+    for (size_t r = 0; r < requests; ++r) {
+        acc += handleRequest<DoublyLinkedList<int>>(lists, len, [] { return DoublyLinkedList<int>(); });
+    }
+    add("DoublyLinkedList", timer.elapsed_ns());
+
+    // One arena per worker, reset between requests; the initial buffer is
+    // sized so that a request never reaches the upstream allocator after
+    // warm-up.
+    std::vector<unsigned char> buffer(lists * len * 64);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    timer.reset();
+    for (size_t r = 0; r < requests; ++r) {
+        acc += handleRequest<list_pmr::DoublyLinkedList<int>>(lists, len, [&] { return list_pmr::DoublyLinkedList<int>(&arena); });
+        arena.release();
+    }
+    add("list_pmr::DoublyLinkedList/monotonic", timer.elapsed_ns());
+
+    timer.reset();
+    for (size_t r = 0; r < requests; ++r) {
+        acc += handleRequest<std::pmr::list<int>>(lists, len, [&] { return std::pmr::list<int>(&arena); });
+        arena.release();
+    }
+    add("std::pmr::list/monotonic", timer.elapsed_ns());
+
+    bench_do_not_optimize(acc);
+    report.print();
+    return 0;
+}
@@ -0,0 +1,119 @@
+// SkipList against std::map: random inserts, point lookups and short range
+// scans in both directions, plus concurrent_insert scaling.
+//
+// usage: bench_skiplist_vs_map [n] [scan_length] [max_threads]
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../SkipList.h"
+#include "BenchHarness.h"
+
+namespace {
+
+std::vector<int> shuffledKeys(size_t n, unsigned seed) {
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+    return keys;
+}
+
+template <typename Container>
+void runSuite(const char* name, const std::vector<int>& keys, size_t scanLength, BenchReporter& report) {
+    const size_t n = keys.size();
+    const int maxLo = static_cast<int>(n > scanLength ? n - scanLength : 1);
+    Container c;
+
+    BenchTimer timer;
+    for (int k : keys) c.insert({k, k});
+    double insertNs = timer.elapsed_ns();
+
+    std::vector<int> probes = shuffledKeys(n, 99);
+    timer.reset();
+    long long acc = 0;
+    for (int k : probes) acc += c.find(k)->second;
+    double findNs = timer.elapsed_ns();
+
+    size_t scans = std::max<size_t>(1, n / scanLength);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> lo(0, maxLo);
+    timer.reset();
+    for (size_t i = 0; i < scans; ++i) {
+        int a = lo(rng);
+        auto first = c.lower_bound(a);
+        auto last = c.lower_bound(a + static_cast<int>(scanLength));
+        for (auto it = first; it != last; ++it) acc += it->second;
+    }
+    double scanNs = timer.elapsed_ns();
+
+    timer.reset();
+    for (size_t i = 0; i < scans; ++i) {
+        int a = lo(rng);
+        auto first = c.lower_bound(a);
+        auto last = c.lower_bound(a + static_cast<int>(scanLength));
+        while (last != first) acc += (--last)->second;
+    }
+    double reverseScanNs = timer.elapsed_ns();
+    bench_do_not_optimize(acc);
+
+    auto add = [&](const char* op, double ns, size_t ops) {
+        report.add("skiplist_vs_map")
+            .set("container", name)
+            .set("op", op)
+            .set("n", static_cast<uint64_t>(n))
+            .set("ns_per_op", ns / static_cast<double>(ops));
+    };
+    add("insert", insertNs, n);
+    add("find", findNs, n);
+    add("range_scan", scanNs, scans * scanLength);
+    add("range_scan_reverse", reverseScanNs, scans * scanLength);
+}
+
+// std::map-compatible shim so runSuite can drive both containers.
+struct SkipListMap : SkipList<int, int> {
+    void insert(const std::pair<int, int>& kv) { SkipList<int, int>::insert(kv.first, kv.second); }
+};
+
+double benchConcurrentInsert(size_t n, unsigned threads) {
+    SkipList<int, int> list;
+    std::vector<int> keys = shuffledKeys(n, 3);
+    std::vector<std::thread> pool;
+    BenchTimer timer;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            for (size_t i = t; i < keys.size(); i += threads) list.concurrent_insert(keys[i], keys[i]);
+        });
+    }
+    for (auto& th : pool) th.join();
+    return timer.elapsed_ns();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    size_t scanLength = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100;
+    unsigned hw = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10))
+                           : std::max(1u, std::thread::hardware_concurrency());
+    scanLength = std::max<size_t>(1, scanLength);
+
+    BenchReporter report;
+    std::vector<int> keys = shuffledKeys(n, 42);
+    runSuite<std::map<int, int>>("std::map", keys, scanLength, report);
+    runSuite<SkipListMap>("SkipList", keys, scanLength, report);
+
+    for (unsigned threads = 1; threads <= hw; threads *= 2) {
+        double ns = benchConcurrentInsert(n, threads);
+        report.add("skiplist_concurrent_insert")
+            .set("threads", static_cast<int>(threads))
+            .set("n", static_cast<uint64_t>(n))
+            .set("ops_per_sec", static_cast<double>(n) * 1e9 / ns);
+    }
+    report.print();
+    return 0;
+}
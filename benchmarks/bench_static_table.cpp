@@ -0,0 +1,132 @@
+// Startup cost of a static routing table: building it at run time, into a
+// DoublyLinkedList (what startup code does today) or a
+// StaticDoublyLinkedList, against a table built during compilation that is
+// only read. Then longest-prefix lookups over each table.
+//
+// The compile-time table is sorted in a transient DoublyLinkedList during
+// constant evaluation and frozen into a StaticDoublyLinkedList, so this
+// benchmark needs C++20.
+//
+// usage: bench_static_table [builds] [lookups]
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../DoublyLinkedList.h"
+#include "../StaticDoublyLinkedList.h"
+#include "BenchHarness.h"
+
+namespace {
+
+struct Route {
+    uint32_t prefix = 0;
+    uint8_t length = 0;
+    uint16_t port = 0;
+};
+
+constexpr size_t kRoutes = 256;
+using StaticTable = StaticDoublyLinkedList<Route, kRoutes>;
+
+constexpr uint32_t prefixMask(uint8_t length) {
+    return length == 0 ? 0 : ~uint32_t(0) << (32 - length);
+}
+
+constexpr Route routeAt(uint32_t i) {
+    uint32_t x = (i + 1) * 0x9e3779b9u;
+    x ^= x >> 15;
+    x *= 0x85ebca6bu;
+    x ^= x >> 13;
+    uint8_t length = static_cast<uint8_t>(8 + x % 25);
+    return Route{x & prefixMask(length), length, static_cast<uint16_t>(1024 + i)};
+}
+
+// Keeps the table ordered by prefix length, longest first, so that the
+// first match of a lookup is the longest one.
+template <typename List>
+constexpr void addRoute(List& table, const Route& route) {
+    size_t index = 0;
+    for (const Route& r : table) {
+        if (r.length < route.length) break;
+        ++index;
+    }
+    table.insert_at(index, route);
+}
+
+template <typename List>
+constexpr void buildTable(List& table) {
+    for (uint32_t i = 0; i < kRoutes; ++i) addRoute(table, routeAt(i));
+}
+
+template <typename List>
+uint16_t lookup(const List& table, uint32_t addr) {
+    for (const Route& r : table) {
+        if ((addr & prefixMask(r.length)) == r.prefix) return r.port;
+    }
+    return 0;
+}
+
+constexpr StaticTable kTable = [] {
+    DoublyLinkedList<Route> sorted;
+    buildTable(sorted);
+    StaticTable table;
+    for (const Route& r : sorted) table.push_back(r);
+    return table;
+}();
+
+static_assert(kTable.size() == kRoutes, "compile-time table is incomplete");
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t builds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+    size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    if (builds == 0) builds = 1;
+
+    BenchReporter report;
+    auto add = [&](const char* table, double buildNs, double lookupNs, size_t bytes) {
+        report.add("static_table")
+            .set("table", table)
+            .set("routes", static_cast<uint64_t>(kRoutes))
+            .set("build_ns", buildNs)
+            .set("ns_per_lookup", lookups ? lookupNs / static_cast<double>(lookups) : 0.0)
+            .set("table_bytes", static_cast<uint64_t>(bytes));
+    };
+
+    std::mt19937 rng(7);
+    std::vector<uint32_t> addrs(lookups);
+    for (auto& a : addrs) a = rng() % 4 == 0 ? routeAt(rng() % kRoutes).prefix | (rng() & 0xff) : rng();
+
+    std::vector<DoublyLinkedList<Route>> linked(builds);
+    BenchTimer timer;
+    for (auto& table : linked) buildTable(table);
+    double linkedBuild = timer.elapsed_ns() / static_cast<double>(builds);
+
+    std::vector<StaticTable> fixed(builds);
+    timer.reset();
+    for (auto& table : fixed) buildTable(table);
+    double fixedBuild = timer.elapsed_ns() / static_cast<double>(builds);
+
+    uint64_t sums[3] = {0, 0, 0};
+    timer.reset();
+    for (uint32_t a : addrs) sums[0] += lookup(linked[0], a);
+    add("runtime_linked", linkedBuild, timer.elapsed_ns(), linked[0].memory_usage().total_bytes());
+
+    timer.reset();
+    for (uint32_t a : addrs) sums[1] += lookup(fixed[0], a);
+    add("runtime_static", fixedBuild, timer.elapsed_ns(), sizeof(StaticTable));
+
+    timer.reset();
+    for (uint32_t a : addrs) sums[2] += lookup(kTable, a);
+    add("constexpr_static", 0.0, timer.elapsed_ns(), sizeof(StaticTable));
+
+    if (sums[0] != sums[1] || sums[0] != sums[2]) {
+        std::cerr << "bench_static_table: tables disagree\n";
+        return 1;
+    }
+    bench_do_not_optimize(sums[0]);
+    report.print();
+    return 0;
+}
@@ -0,0 +1,129 @@
+// TimerWheel against an ordered std::multimap timer queue: schedule n
+// timers with random delays, cancel half of them, then tick until every
+// remaining timer has fired. Also times a round-robin scheduler ring
+// served by CircularDoublyLinkedList::rotate() against
+// DoublyLinkedList::rotate_left(1).
+//
+// usage: bench_timer_wheel [timers] [max_delay] [ring_size]
+
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../CircularDoublyLinkedList.h"
+#include "../DoublyLinkedList.h"
+#include "../TimerWheel.h"
+#include "BenchHarness.h"
+
+namespace {
+
+struct Result {
+    double schedule_ns;
+    double cancel_ns;
+    double drain_ns;
+    size_t fired;
+};
+
+Result runWheel(const std::vector<uint64_t>& delays) {
+    TimerWheel<uint32_t> wheel;
+    std::vector<TimerWheel<uint32_t>::TimerId> ids(delays.size());
+    Result r{};
+    BenchTimer timer;
+    for (size_t i = 0; i < delays.size(); ++i) ids[i] = wheel.schedule(delays[i], static_cast<uint32_t>(i));
+    r.schedule_ns = timer.elapsed_ns();
+    timer.reset();
+    for (size_t i = 0; i < ids.size(); i += 2) wheel.cancel(ids[i]);
+    r.cancel_ns = timer.elapsed_ns();
+    uint64_t sum = 0;
+    timer.reset();
+    while (!wheel.empty()) r.fired += wheel.tick([&](uint32_t& id) { sum += id; });
+    r.drain_ns = timer.elapsed_ns();
+    bench_do_not_optimize(sum);
+    return r;
+}
+
+Result runMultimap(const std::vector<uint64_t>& delays) {
+    std::multimap<uint64_t, uint32_t> queue;
+    std::vector<std::multimap<uint64_t, uint32_t>::iterator> ids(delays.size());
+    uint64_t now = 0;
+    Result r{};
+    BenchTimer timer;
+    for (size_t i = 0; i < delays.size(); ++i) ids[i] = queue.emplace(now + delays[i], static_cast<uint32_t>(i));
+    r.schedule_ns = timer.elapsed_ns();
+    timer.reset();
+    for (size_t i = 0; i < ids.size(); i += 2) queue.erase(ids[i]);
+    r.cancel_ns = timer.elapsed_ns();
+    uint64_t sum = 0;
+    timer.reset();
+    while (!queue.empty()) {
+        ++now;
+        while (!queue.empty() && queue.begin()->first <= now) {
+            sum += queue.begin()->second;
+            queue.erase(queue.begin());
+            ++r.fired;
+        }
+    }
+    r.drain_ns = timer.elapsed_ns();
+    bench_do_not_optimize(sum);
+    return r;
+}
+
+template <typename Ring, typename Rotate>
+double runRing(size_t ringSize, size_t turns, Rotate rotate) {
+    Ring ring;
+    for (size_t i = 0; i < ringSize; ++i) ring.push_back(static_cast<int>(i));
+    long long served = 0;
+    BenchTimer timer;
+    for (size_t t = 0; t < turns; ++t) {
+        served += ring.front();
+        rotate(ring);
+    }
+    double ns = timer.elapsed_ns();
+    bench_do_not_optimize(served);
+    return ns / static_cast<double>(turns);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    uint64_t maxDelay = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+    size_t ringSize = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000;
+    if (maxDelay == 0) maxDelay = 1;
+
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> delays(n);
+    for (auto& d : delays) d = 1 + rng() % maxDelay;
+
+    BenchReporter report;
+    auto add = [&](const char* container, const Result& r) {
+        double half = static_cast<double>(n / 2 + n % 2);
+        report.add("timer_wheel")
+            .set("container", container)
+            .set("timers", static_cast<uint64_t>(n))
+            .set("max_delay", maxDelay)
+            .set("schedule_ns", n ? r.schedule_ns / static_cast<double>(n) : 0.0)
+            .set("cancel_ns", half ? r.cancel_ns / half : 0.0)
+            .set("drain_ms", r.drain_ns / 1e6)
+            .set("fired", static_cast<uint64_t>(r.fired));
+    };
+    add("TimerWheel", runWheel(delays));
+    add("std::multimap", runMultimap(delays));
+
+    size_t turns = 10000000;
+    auto addRing = [&](const char* container, double ns) {
+        report.add("round_robin")
+            .set("container", container)
+            .set("ring_size", static_cast<uint64_t>(ringSize))
+            .set("ns_per_turn", ns);
+    };
+    addRing("CircularDoublyLinkedList::rotate",
+            runRing<CircularDoublyLinkedList<int>>(ringSize, turns, [](auto& r) { r.rotate(); }));
+    addRing("DoublyLinkedList::rotate_left(1)",
+            runRing<DoublyLinkedList<int>>(ringSize, turns, [](auto& r) { r.rotate_left(1); }));
+
+    report.print();
+    return 0;
+}
@@ -0,0 +1,946 @@
+// Differential fuzz harness: runs one operation sequence on DoublyLinkedList,
+// SinglyLinkedList, AdaptiveList, StaticDoublyLinkedList, CowDoublyLinkedList
+// and std::list and checks after every operation that the lists hold the
+// same elements and that every operation returned the same result. The
+// lists other than DoublyLinkedList only take the operations they have;
+// each is checked against a std::list of its own that sees the same subset.
+// Documented invariants that a plain comparison cannot see (a copy is
+// independent of references taken before it, copy-on-write snapshots keep
+// their contents) are checked where they apply.
+//
+// An input is decoded into operations three bytes at a time (opcode, value,
+// index); values are kept small so that duplicates, removals and unique()
+// have something to do. The first byte switches hash tracking on, in which
+// case DoublyLinkedList::hash() is also compared with a from-scratch hash
+// after every operation.
+//
+// Built with -DLINKED_LIST_LIBFUZZER this file is a libFuzzer target.
+// Otherwise it is a standalone program:
+//
+//   list_fuzz [--iterations N] [--seed S] [--max-ops M]   random inputs
+//   list_fuzz --replay FILE...          raw inputs (e.g. libFuzzer crashes)
+//   list_fuzz --trace FILE...           check recorded operation traces
+//   list_fuzz --record FILE [--profile mixed|ends|indexed|splice]
+//             [--ops N] [--seed S]      record a random trace
+//   list_fuzz --perf [--samples S] [--baseline FILE] [--tolerance X]
+//             [--write-baseline FILE] FILE...
+//
+// Traces are text, one "<op> <value> <index>" line per operation, so a
+// failing input can be dumped, minimized by hand and kept. --perf replays
+// traces without the checks. One trace replays in well under a
+// millisecond, too short to time reliably, so each sample replays it as
+// many times as it takes to fill kMinSampleNs, and the median of S samples
+// (default 7) is reported per container. With --baseline it fails when
+// that is slower than tolerance (default 1.5) times the recorded baseline.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../AdaptiveList.h"
+#include "../CowDoublyLinkedList.h"
+#include "../DoublyLinkedList.h"
+#include "../SinglyLinkedList.h"
+#include "../StaticDoublyLinkedList.h"
+#include "../benchmarks/BenchHarness.h"
+
+namespace {
+
+enum OpCode : uint8_t {
+    // Operations SinglyLinkedList has too.
+    PushFront,
+    PushBack,
+    PopFront,
+    PopBack,
+    InsertAt,
+    EraseAt,
+    RemoveFirst,
+    RemoveAll,
+    Reverse,
+    Clear,
+    Contains,
+    Peek,
+    // DoublyLinkedList and std::list only.
+    EraseIf,
+    Unique,
+    Sort,
+    FillOther,
+    SpliceAll,
+    SpliceOne,
+    SpliceRange,
+    Merge,
+    RotateLeft,
+    TakeFront,
+    CopyAssign,
+    EraseRange,
+    kOpCount
+};
+
+constexpr uint8_t kFirstDoublyOnly = EraseIf;
+
+const char* const kOpNames[kOpCount] = {
+    "push_front", "push_back",  "pop_front",    "pop_back",    "insert_at",   "erase_at",
+    "remove_first", "remove_all", "reverse",    "clear",       "contains",    "peek",
+    "erase_if",   "unique",     "sort",         "fill_other",  "splice_all",  "splice_one",
+    "splice_range", "merge",    "rotate_left",  "take_front",  "copy_assign", "erase_range",
+};
+
+struct Op {
+    uint8_t code;
+    int value;
+    uint32_t index;
+};
+
+constexpr int kValueRange = 32;
+
+// Position index % (n + 1): anything from the front to one past the back.
+size_t pick(uint32_t index, size_t n) { return index % (n + 1); }
+
+void writeOp(std::ostream& os, const Op& op) {
+    os << kOpNames[op.code] << ' ' << op.value << ' ' << op.index << '\n';
+}
+
+// Each apply function performs one operation and returns its observable
+// result (a returned flag or count, a value read), 0 when there is none.
+// `other` is a second list used as the source of splices and merges.
+
+using Dll = DoublyLinkedList<int>;
+using Ref = std::list<int>;
+
+template <typename It>
+It nth(It first, size_t n) {
+    return std::next(first, static_cast<std::ptrdiff_t>(n));
+}
+
+long long applyDll(Dll& list, Dll& other, const Op& op) {
+    const int v = op.value;
+    switch (op.code) {
+    case PushFront: list.push_front(v); return 0;
+    case PushBack: list.push_back(v); return 0;
+    case PopFront: return list.pop_front();
+    case PopBack: return list.pop_back();
+    case InsertAt: return list.insert_at(pick(op.index, list.size()), v);
+    case EraseAt: return list.erase_at(pick(op.index, list.size()));
+    case RemoveFirst: return list.remove_first(v);
+    case RemoveAll: return list.remove_all(v);
+    case Reverse: list.reverse(); return 0;
+    case Clear: list.clear(); return 0;
+    case Contains: return list.contains(v);
+    case Peek: {
+        if (list.empty()) return -1;
+        const Dll& c = list;
+        return c.front() * 1000000LL + c.back() * 1000LL + c.at(op.index % c.size());
+    }
+    case EraseIf: return static_cast<long long>(list.erase_if([v](int x) { return x % (v % 3 + 2) == 0; }));
+    case Unique: list.unique(); return 0;
+    case Sort: list.sort_ascending(); return 0;
+    case FillOther:
+        if (op.index % 2) other.push_back(v);
+        else other.push_front(v);
+        return 0;
+    case SpliceAll: list.splice(nth(list.cbegin(), pick(op.index, list.size())), other); return 0;
+    case SpliceOne: {
+        if (other.empty()) return 0;
+        auto it = nth(other.cbegin(), static_cast<size_t>(v) % other.size());
+        list.splice(nth(list.cbegin(), pick(op.index, list.size())), other, it);
+        return 0;
+    }
+    case SpliceRange: {
+        size_t a = pick(static_cast<uint32_t>(v), other.size());
+        size_t b = a + pick(op.index >> 8, other.size() - a);
+        list.splice(nth(list.cbegin(), pick(op.index, list.size())), other, nth(other.cbegin(), a),
+                    nth(other.cbegin(), b));
+        return 0;
+    }
+    case Merge:
+        list.sort_ascending();
+        other.sort_ascending();
+        list.merge(other);
+        return 0;
+    case RotateLeft: list.rotate_left(op.index); return 0;
+    case TakeFront: {
+        Dll front = list.take_front(pick(op.index, list.size()));
+        long long n = static_cast<long long>(front.size());
+        other.splice(other.cend(), front);
+        return n;
+    }
+    case CopyAssign: {
+        Dll copy(list);
+        if (op.index % 2) other = copy;
+        else list = copy;
+        return static_cast<long long>(copy.size());
+    }
+    case EraseRange: {
+        size_t a = pick(op.index, list.size());
+        size_t b = a + pick(static_cast<uint32_t>(v), list.size() - a);
+        auto last = list.erase(nth(list.cbegin(), a), nth(list.cbegin(), b));
+        return last == list.end() ? -1 : *last;
+    }
+    }
+    return 0;
+}
+
+long long applyRef(Ref& list, Ref& other, const Op& op) {
+    const int v = op.value;
+    switch (op.code) {
+    case PushFront: list.push_front(v); return 0;
+    case PushBack: list.push_back(v); return 0;
+    case PopFront:
+        if (list.empty()) return 0;
+        list.pop_front();
+        return 1;
+    case PopBack:
+        if (list.empty()) return 0;
+        list.pop_back();
+        return 1;
+    case InsertAt: list.insert(nth(list.begin(), pick(op.index, list.size())), v); return 1;
+    case EraseAt: {
+        size_t i = pick(op.index, list.size());
+        if (i == list.size()) return 0;
+        list.erase(nth(list.begin(), i));
+        return 1;
+    }
+    case RemoveFirst: {
+        auto it = std::find(list.begin(), list.end(), v);
+        if (it == list.end()) return 0;
+        list.erase(it);
+        return 1;
+    }
+    case RemoveAll: {
+        size_t before = list.size();
+        list.remove(v);
+        return static_cast<long long>(before - list.size());
+    }
+    case Reverse: list.reverse(); return 0;
+    case Clear: list.clear(); return 0;
+    case Contains: return std::find(list.begin(), list.end(), v) != list.end();
+    case Peek:
+        if (list.empty()) return -1;
+        return list.front() * 1000000LL + list.back() * 1000LL + *nth(list.begin(), op.index % list.size());
+    case EraseIf: {
+        size_t before = list.size();
+        list.remove_if([v](int x) { return x % (v % 3 + 2) == 0; });
+        return static_cast<long long>(before - list.size());
+    }
+    case Unique: list.unique(); return 0;
+    case Sort: list.sort(); return 0;
+    case FillOther:
+        if (op.index % 2) other.push_back(v);
+        else other.push_front(v);
+        return 0;
+    case SpliceAll: list.splice(nth(list.begin(), pick(op.index, list.size())), other); return 0;
+    case SpliceOne: {
+        if (other.empty()) return 0;
+        auto it = nth(other.begin(), static_cast<size_t>(v) % other.size());
+        list.splice(nth(list.begin(), pick(op.index, list.size())), other, it);
+        return 0;
+    }
+    case SpliceRange: {
+        size_t a = pick(static_cast<uint32_t>(v), other.size());
+        size_t b = a + pick(op.index >> 8, other.size() - a);
+        list.splice(nth(list.begin(), pick(op.index, list.size())), other, nth(other.begin(), a),
+                    nth(other.begin(), b));
+        return 0;
+    }
+    case Merge:
+        list.sort();
+        other.sort();
+        list.merge(other);
+        return 0;
+    case RotateLeft:
+        if (!list.empty()) std::rotate(list.begin(), nth(list.begin(), op.index % list.size()), list.end());
+        return 0;
+    case TakeFront: {
+        size_t k = pick(op.index, list.size());
+        other.splice(other.end(), list, list.begin(), nth(list.begin(), k));
+        return static_cast<long long>(k);
+    }
+    case CopyAssign: {
+        Ref copy(list);
+        if (op.index % 2) other = copy;
+        else list = copy;
+        return static_cast<long long>(copy.size());
+    }
+    case EraseRange: {
+        size_t a = pick(op.index, list.size());
+        size_t b = a + pick(static_cast<uint32_t>(v), list.size() - a);
+        auto last = list.erase(nth(list.begin(), a), nth(list.begin(), b));
+        return last == list.end() ? -1 : *last;
+    }
+    }
+    return 0;
+}
+
+// SinglyLinkedList throws where the others return false; a throw counts as
+// result 0, so the comparison also checks that it throws exactly then.
+long long applySll(SinglyLinkedList& list, const Op& op) {
+    const int v = op.value;
+    try {
+        switch (op.code) {
+        case PushFront: list.push_front(v); return 0;
+        case PushBack: list.push_back(v); return 0;
+        case PopFront: list.pop_front(); return 1;
+        case PopBack: list.pop_back(); return 1;
+        case InsertAt: list.insert_at(pick(op.index, list.size()), v); return 1;
+        case EraseAt: list.erase_at(pick(op.index, list.size())); return 1;
+        case RemoveFirst: return list.remove_first(v);
+        case RemoveAll: return list.remove_all(v);
+        case Reverse: list.reverse(); return 0;
+        case Clear: list.clear(); return 0;
+        case Contains: return list.contains(v);
+        case Peek: {
+            if (list.empty()) return -1;
+            std::vector<int> all = list.to_vector();
+            return list.front() * 1000000LL + list.back() * 1000LL + all[op.index % all.size()];
+        }
+        default: return 0;
+        }
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+// The remaining containers return false for an operation they do not
+// have, which is then not applied to their reference either, and report
+// their result through `result`.
+
+using Adaptive = AdaptiveList<int>;
+
+// Now and then (picked by index and value) also pins the list to a layout
+// or unpins it, so that every operation meets both layouts and migrations
+// happen in the middle of a trace.
+bool applyAdaptive(Adaptive& list, Adaptive& other, const Op& op, long long& result) {
+    if (op.index % 37 == 0) {
+        if (op.value % 3 == 0) list.pin(ListRepresentation::Contiguous);
+        else if (op.value % 3 == 1) list.pin(ListRepresentation::Linked);
+        else list.unpin();
+    }
+    const int v = op.value;
+    result = 0;
+    switch (op.code) {
+    case PushFront: list.push_front(v); return true;
+    case PushBack: list.push_back(v); return true;
+    case PopFront: result = list.pop_front(); return true;
+    case PopBack: result = list.pop_back(); return true;
+    case InsertAt: result = list.insert_at(pick(op.index, list.size()), v); return true;
+    case EraseAt: result = list.erase_at(pick(op.index, list.size())); return true;
+    case RemoveFirst: {
+        int i = list.find_first_index(v);
+        result = i >= 0 && list.erase_at(static_cast<size_t>(i));
+        return true;
+    }
+    case RemoveAll: result = list.remove_all(v); return true;
+    case Reverse: list.reverse(); return true;
+    case Clear: list.clear(); return true;
+    case Contains: result = list.contains(v); return true;
+    case Peek: {
+        const Adaptive& c = list;
+        result = c.empty() ? -1 : c.front() * 1000000LL + c.back() * 1000LL + c.at(op.index % c.size());
+        return true;
+    }
+    case EraseIf:
+        result = static_cast<long long>(list.erase_if([v](int x) { return x % (v % 3 + 2) == 0; }));
+        return true;
+    case Sort: list.sort_ascending(); return true;
+    case FillOther:
+        if (op.index % 2) other.push_back(v);
+        else other.push_front(v);
+        return true;
+    case SpliceAll: list.splice(pick(op.index, list.size()), other); return true;
+    case CopyAssign: {
+        // Copies into other, then spliced back, would double the list
+        // every time: there is no take_front() to drain it.
+        if (op.index % 2) return false;
+        Adaptive copy(list);
+        list = copy;
+        result = static_cast<long long>(copy.size());
+        return true;
+    }
+    default: return false;
+    }
+}
+
+// Throws when a documented invariant does not hold; runChecked() reports
+// it like a mismatch.
+void expect(bool holds, const char* what) {
+    if (!holds) throw std::logic_error(what);
+}
+
+// Small enough that the traces fill it, so that erased slots are reused
+// through the free list. Operations that would overflow it are skipped.
+using Static = StaticDoublyLinkedList<int, 48>;
+
+bool applyStatic(Static& list, Static& other, const Op& op, long long& result) {
+    const int v = op.value;
+    result = 0;
+    switch (op.code) {
+    case PushFront:
+        if (list.full()) return false;
+        list.push_front(v);
+        return true;
+    case PushBack:
+        if (list.full()) return false;
+        list.push_back(v);
+        return true;
+    case PopFront: result = list.pop_front(); return true;
+    case PopBack: result = list.pop_back(); return true;
+    case InsertAt:
+        if (list.full()) return false;
+        result = list.insert_at(pick(op.index, list.size()), v);
+        return true;
+    case EraseAt: result = list.erase_at(pick(op.index, list.size())); return true;
+    case RemoveFirst: {
+        auto it = std::find(list.cbegin(), list.cend(), v);
+        result = it != list.cend();
+        list.erase(it);
+        return true;
+    }
+    case Reverse: list.reverse(); return true;
+    case Clear: list.clear(); return true;
+    case Contains: result = list.contains(v); return true;
+    case Peek: {
+        const Static& c = list;
+        result = c.empty() ? -1 : c.front() * 1000000LL + c.back() * 1000LL + c.at(op.index % c.size());
+        return true;
+    }
+    case FillOther:
+        if (other.full()) return false;
+        if (op.index % 2) other.push_back(v);
+        else other.push_front(v);
+        return true;
+    case CopyAssign: {
+        // The copy owns its slots: a write through a reference taken
+        // before it stays out of the copy.
+        size_t at = list.empty() ? 0 : op.index % list.size();
+        int* ref = list.empty() ? nullptr : &list.at(at);
+        Static copy(list);
+        if (ref) {
+            *ref += 1000;
+            expect(copy.at(at) == *ref - 1000, "StaticDoublyLinkedList copy sees a write to the original");
+            *ref -= 1000;
+        }
+        if (op.index % 2) other = copy;
+        else list = copy;
+        result = static_cast<long long>(copy.size());
+        return true;
+    }
+    case EraseRange: {
+        size_t a = pick(op.index, list.size());
+        size_t b = a + pick(static_cast<uint32_t>(v), list.size() - a);
+        auto last = list.erase(nth(list.cbegin(), a), nth(list.cbegin(), b));
+        result = last == list.end() ? -1 : *last;
+        return true;
+    }
+    default: return false;
+    }
+}
+
+// Elements front to back, after checking that the prev links walk them
+// back to front.
+std::vector<int> staticItems(const Static& list) {
+    std::vector<int> items(list.begin(), list.end());
+    expect(std::equal(list.crbegin(), list.crend(), items.rbegin(), items.rend()),
+           "StaticDoublyLinkedList backward walk differs");
+    return items;
+}
+
+using Cow = CowDoublyLinkedList<int>;
+
+// Positions are taken through a const view, so that while the body is
+// shared erase() gets iterators into the shared body and has to carry
+// them over to its detached copy. Non-const access now and then marks the
+// body unshareable.
+bool applyCow(Cow& list, Cow& other, const Op& op, long long& result) {
+    const Cow& view = list;
+    const int v = op.value;
+    result = 0;
+    switch (op.code) {
+    case PushFront: list.push_front(v); return true;
+    case PushBack: list.push_back(v); return true;
+    case PopFront: result = list.pop_front(); return true;
+    case PopBack: result = list.pop_back(); return true;
+    case InsertAt: result = list.insert_at(pick(op.index, list.size()), v); return true;
+    case EraseAt: {
+        size_t i = pick(op.index, list.size());
+        if (i == list.size()) return true;
+        list.erase(nth(view.begin(), i));
+        result = 1;
+        return true;
+    }
+    case RemoveFirst: {
+        auto it = std::find(view.begin(), view.end(), v);
+        if (it == view.end()) return true;
+        list.erase(it);
+        result = 1;
+        return true;
+    }
+    case RemoveAll: result = list.remove_all(v); return true;
+    case Reverse: list.reverse(); return true;
+    case Clear: list.clear(); return true;
+    case Contains: result = view.contains(v); return true;
+    case Peek:
+        if (view.empty()) result = -1;
+        else if (op.index % 4 == 1) result = list.front() * 1000000LL + list.back() * 1000LL + list.at(op.index % list.size());
+        else result = view.front() * 1000000LL + view.back() * 1000LL + view.at(op.index % view.size());
+        return true;
+    case EraseIf:
+        result = static_cast<long long>(list.erase_if([v](int x) { return x % (v % 3 + 2) == 0; }));
+        return true;
+    case Unique: list.unique(); return true;
+    case Sort: list.sort_ascending(); return true;
+    case FillOther:
+        if (op.index % 2) other.push_back(v);
+        else other.push_front(v);
+        return true;
+    case CopyAssign: {
+        // A reference handed out before the copy keeps the body out of
+        // sharing: writing through it must not reach the copy.
+        size_t at = list.empty() ? 0 : op.index % list.size();
+        int* ref = list.empty() ? nullptr : &list.at(at);
+        Cow copy(list);
+        if (ref) {
+            *ref += 1000;
+            const Cow& copyView = copy;
+            expect(copyView.at(at) == *ref - 1000, "CowDoublyLinkedList copy sees a write through an earlier reference");
+            *ref -= 1000;
+        }
+        if (op.index % 2) other = copy;
+        else list = copy;
+        result = static_cast<long long>(copy.size());
+        return true;
+    }
+    case EraseRange: {
+        size_t a = pick(op.index, list.size());
+        size_t b = a + pick(static_cast<uint32_t>(v), list.size() - a);
+        auto last = list.erase(nth(view.begin(), a), nth(view.begin(), b));
+        result = last == list.end() ? -1 : *last;
+        return true;
+    }
+    default: return false;
+    }
+}
+
+std::vector<Op> decode(const uint8_t* data, size_t size, bool& trackHash) {
+    trackHash = size > 0 && (data[0] & 1);
+    std::vector<Op> ops;
+    for (size_t i = 1; i + 2 < size; i += 3) {
+        Op op;
+        op.code = static_cast<uint8_t>(data[i] % kOpCount);
+        op.value = data[i + 1] % kValueRange;
+        op.index = data[i + 2] | (static_cast<uint32_t>(data[i + 1]) << 8);
+        ops.push_back(op);
+    }
+    return ops;
+}
+
+[[noreturn]] void fail(const std::vector<Op>& ops, size_t at, const std::string& what) {
+    std::cerr << "list_fuzz: mismatch after op #" << at << " (";
+    std::ostringstream line;
+    writeOp(line, ops[at]);
+    std::string s = line.str();
+    s.pop_back();
+    std::cerr << s << "): " << what << "\n--- trace ---\n";
+    for (size_t i = 0; i <= at; ++i) writeOp(std::cerr, ops[i]);
+    std::abort();
+}
+
+uint64_t freshHash(const Ref& ref) {
+    Dll fresh;
+    for (int v : ref) fresh.push_back(v);
+    return fresh.hash();
+}
+
+template <typename List>
+bool sameElements(const List& list, const Ref& ref) {
+    return list.size() == ref.size() && std::equal(list.begin(), list.end(), ref.begin(), ref.end());
+}
+
+// Checks one container after op #i of ops: its result, its contents and
+// those of its second list against the std::list references.
+void checkLane(const std::vector<Op>& ops, size_t i, const std::string& name, long long got, long long want,
+               const std::vector<int>& items, const Ref& ref, const std::vector<int>& otherItems,
+               const Ref& refOther) {
+    if (got != want) fail(ops, i, name + " returned " + std::to_string(got) + ", std::list " + std::to_string(want));
+    if (!sameElements(items, ref)) fail(ops, i, name + " elements differ");
+    if (!sameElements(otherItems, refOther)) fail(ops, i, "second " + name + " differs");
+}
+
+// Runs ops on all the lists, checking after each one.
+void runChecked(const std::vector<Op>& ops, bool trackHash) {
+    Dll dll, dllOther;
+    Ref ref, refOther;
+    SinglyLinkedList sll;
+    Ref sllRef, sllRefOther;
+    Adaptive adaptive, adaptiveOther;
+    Ref adaptiveRef, adaptiveRefOther;
+    Static fixed, fixedOther;
+    Ref fixedRef, fixedRefOther;
+    Cow cow, cowOther;
+    Ref cowRef, cowRefOther;
+    // Copies of cow taken along the way, with what they held; they share
+    // its body until it is written.
+    std::vector<std::pair<Cow, Ref>> snapshots;
+    if (trackHash) dll.enable_hash_tracking();
+
+    for (size_t i = 0; i < ops.size(); ++i) {
+        const Op& op = ops[i];
+        long long got = applyDll(dll, dllOther, op);
+        long long want = applyRef(ref, refOther, op);
+        if (got != want) fail(ops, i, "DoublyLinkedList returned " + std::to_string(got) + ", std::list " + std::to_string(want));
+        if (!sameElements(dll, ref)) fail(ops, i, "DoublyLinkedList elements differ");
+        if (!std::equal(dll.crbegin(), dll.crend(), ref.rbegin(), ref.rend())) {
+            fail(ops, i, "DoublyLinkedList backward walk differs");
+        }
+        if (!sameElements(dllOther, refOther)) fail(ops, i, "second DoublyLinkedList differs");
+        if (trackHash && dll.hash() != freshHash(ref)) {
+            fail(ops, i, "DoublyLinkedList hash differs from a fresh list's");
+        }
+
+        if (op.code < kFirstDoublyOnly) {
+            got = applySll(sll, op);
+            want = applyRef(sllRef, sllRefOther, op);
+            if (got != want) fail(ops, i, "SinglyLinkedList returned " + std::to_string(got) + ", std::list " + std::to_string(want));
+            std::vector<int> all = sll.to_vector();
+            if (sll.size() != sllRef.size() || !std::equal(all.begin(), all.end(), sllRef.begin(), sllRef.end())) {
+                fail(ops, i, "SinglyLinkedList elements differ");
+            }
+        }
+
+        if (applyAdaptive(adaptive, adaptiveOther, op, got)) {
+            want = applyRef(adaptiveRef, adaptiveRefOther, op);
+            checkLane(ops, i, "AdaptiveList", got, want, adaptive.to_vector(), adaptiveRef, adaptiveOther.to_vector(),
+                      adaptiveRefOther);
+        }
+
+        try {
+            if (applyStatic(fixed, fixedOther, op, got)) {
+                want = applyRef(fixedRef, fixedRefOther, op);
+                checkLane(ops, i, "StaticDoublyLinkedList", got, want, staticItems(fixed), fixedRef,
+                          staticItems(fixedOther), fixedRefOther);
+            }
+        } catch (const std::exception& e) {
+            fail(ops, i, e.what());
+        }
+
+        try {
+            if (applyCow(cow, cowOther, op, got)) {
+                want = applyRef(cowRef, cowRefOther, op);
+                checkLane(ops, i, "CowDoublyLinkedList", got, want, cow.to_vector(), cowRef, cowOther.to_vector(),
+                          cowRefOther);
+            }
+            for (const auto& snap : snapshots) {
+                if (!sameElements(snap.first.list(), snap.second)) fail(ops, i, "CowDoublyLinkedList snapshot changed");
+            }
+            if (op.index % 8 == 0) {
+                if (snapshots.size() < 4) snapshots.emplace_back(cow, cowRef);
+                else snapshots[static_cast<size_t>(op.value) % 4] = std::make_pair(Cow(cow), cowRef);
+            }
+        } catch (const std::exception& e) {
+            fail(ops, i, e.what());
+        }
+    }
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    bool trackHash;
+    std::vector<Op> ops = decode(data, size, trackHash);
+    runChecked(ops, trackHash);
+    return 0;
+}
+
+#ifndef LINKED_LIST_LIBFUZZER
+
+namespace {
+
+std::vector<Op> loadTrace(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot open " + path);
+    std::map<std::string, uint8_t> codes;
+    for (uint8_t c = 0; c < kOpCount; ++c) codes[kOpNames[c]] = c;
+    std::vector<Op> ops;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string name;
+        Op op;
+        if (!(fields >> name >> op.value >> op.index) || !codes.count(name)) {
+            throw std::runtime_error(path + ": bad trace line: " + line);
+        }
+        op.code = codes[name];
+        ops.push_back(op);
+    }
+    return ops;
+}
+
+std::vector<uint8_t> readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open " + path);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Relative opcode weights of the --record profiles.
+std::vector<unsigned> profileWeights(const std::string& profile) {
+    std::vector<unsigned> w(kOpCount, 1);
+    if (profile == "ends") {
+        w[PushFront] = w[PushBack] = 12;
+        w[PopFront] = w[PopBack] = 10;
+        w[Peek] = 6;
+        w[Clear] = 0;
+    } else if (profile == "indexed") {
+        w[PushBack] = 6;
+        w[InsertAt] = 12;
+        w[EraseAt] = 8;
+        w[Peek] = 8;
+        w[Clear] = 0;
+    } else if (profile == "splice") {
+        w[PushBack] = 6;
+        w[FillOther] = 10;
+        w[SpliceAll] = 2;
+        w[SpliceOne] = 6;
+        w[SpliceRange] = 6;
+        w[TakeFront] = 4;
+        w[Merge] = 1;
+        w[Clear] = 0;
+    } else if (profile == "mixed") {
+        w[PushFront] = w[PushBack] = 6;
+        w[InsertAt] = 4;
+        w[Clear] = 0;
+    } else {
+        throw std::runtime_error("unknown profile " + profile);
+    }
+    return w;
+}
+
+std::string traceName(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+struct PerfRun {
+    std::string trace;
+    std::string container;
+    double nsPerOp = 0;
+    size_t replaysPerSample = 0;
+    double spread = 0;   // slowest sample / fastest sample
+};
+
+constexpr double kMinSampleNs = 10e6;
+
+// Times `samples` samples of `reps` replays each, with reps doubled until
+// one sample takes at least kMinSampleNs, and keeps the median.
+template <typename Replay>
+PerfRun medianOf(std::string trace, std::string container, size_t samples, size_t ops, Replay replay) {
+    PerfRun run{std::move(trace), std::move(container)};
+    size_t reps = 1;
+    for (;;) {
+        BenchTimer timer;
+        for (size_t r = 0; r < reps; ++r) replay();
+        if (timer.elapsed_ns() >= kMinSampleNs || reps >= (size_t(1) << 30)) break;
+        reps *= 2;
+    }
+    std::vector<double> ns(samples);
+    for (auto& t : ns) {
+        BenchTimer timer;
+        for (size_t r = 0; r < reps; ++r) replay();
+        t = timer.elapsed_ns();
+    }
+    std::sort(ns.begin(), ns.end());
+    run.replaysPerSample = reps;
+    run.spread = ns.front() > 0 ? ns.back() / ns.front() : 0.0;
+    if (ops) run.nsPerOp = ns[samples / 2] / static_cast<double>(reps * ops);
+    return run;
+}
+
+const char* const kPerfContainers[] = {"DoublyLinkedList", "std::list", "SinglyLinkedList"};
+
+// Replays ops on container c (an index into kPerfContainers);
+// SinglyLinkedList takes only the operations it has.
+PerfRun measure(const std::string& trace, const std::vector<Op>& ops, size_t c, size_t samples) {
+    long long sink = 0;
+    PerfRun run;
+    if (c == 0) {
+        run = medianOf(trace, kPerfContainers[c], samples, ops.size(), [&] {
+            Dll list, other;
+            for (const Op& op : ops) sink += applyDll(list, other, op);
+        });
+    } else if (c == 1) {
+        run = medianOf(trace, kPerfContainers[c], samples, ops.size(), [&] {
+            Ref list, other;
+            for (const Op& op : ops) sink += applyRef(list, other, op);
+        });
+    } else {
+        size_t common = static_cast<size_t>(std::count_if(ops.begin(), ops.end(), [](const Op& op) {
+            return op.code < kFirstDoublyOnly;
+        }));
+        run = medianOf(trace, kPerfContainers[c], samples, common, [&] {
+            SinglyLinkedList list;
+            for (const Op& op : ops) {
+                if (op.code < kFirstDoublyOnly) sink += applySll(list, op);
+            }
+        });
+    }
+    bench_do_not_optimize(sink);
+    return run;
+}
+
+// A replay over the baseline is measured again up to this many times and
+// the fastest median kept, so that one burst of machine noise does not
+// fail the check.
+constexpr int kPerfRetries = 2;
+
+int runPerf(const std::vector<std::string>& traces, size_t samples, const std::string& baseline,
+            double tolerance, const std::string& writeBaseline) {
+    std::map<std::string, double> expected;
+    if (!baseline.empty()) {
+        std::ifstream in(baseline);
+        if (!in) throw std::runtime_error("cannot open " + baseline);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream fields(line);
+            std::string trace, container;
+            double ns;
+            if (fields >> trace >> container >> ns) expected[trace + ' ' + container] = ns;
+        }
+    }
+
+    std::vector<PerfRun> runs;
+    int regressions = 0;
+    for (const auto& path : traces) {
+        std::vector<Op> ops = loadTrace(path);
+        std::string name = traceName(path);
+        for (size_t c = 0; c < 3; ++c) {
+            PerfRun run = measure(name, ops, c, samples);
+            if (!baseline.empty()) {
+                auto it = expected.find(name + ' ' + run.container);
+                if (it == expected.end()) {
+                    std::cerr << "list_fuzz: no baseline for " << name << ' ' << run.container << "\n";
+                } else {
+                    for (int retry = 0; retry < kPerfRetries && run.nsPerOp > it->second * tolerance; ++retry) {
+                        PerfRun again = measure(name, ops, c, samples);
+                        if (again.nsPerOp < run.nsPerOp) run = again;
+                    }
+                    if (run.nsPerOp > it->second * tolerance) {
+                        std::cerr << "list_fuzz: regression: " << name << ' ' << run.container << ' ' << run.nsPerOp
+                                  << " ns/op, baseline " << it->second << "\n";
+                        ++regressions;
+                    }
+                }
+            }
+            runs.push_back(run);
+        }
+    }
+
+    BenchReporter report;
+    for (const auto& run : runs) {
+        report.add("trace_replay")
+            .set("trace", run.trace)
+            .set("container", run.container)
+            .set("ns_per_op", run.nsPerOp)
+            .set("replays_per_sample", static_cast<uint64_t>(run.replaysPerSample))
+            .set("spread", run.spread);
+    }
+    report.print();
+
+    if (!writeBaseline.empty()) {
+        std::ofstream out(writeBaseline);
+        if (!out) throw std::runtime_error("cannot write " + writeBaseline);
+        out << "# trace container ns_per_op\n";
+        for (const auto& run : runs) out << run.trace << ' ' << run.container << ' ' << run.nsPerOp << '\n';
+    }
+    return regressions ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string mode = "random";
+    std::vector<std::string> files;
+    size_t iterations = 1000, maxOps = 400, ops = 2000, samples = 7;
+    uint64_t seed = 1;
+    double tolerance = 1.5;
+    std::string profile = "mixed", record, baseline, writeBaseline;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::runtime_error(arg + " needs a value");
+            return argv[++i];
+        };
+        if (arg == "--iterations") iterations = std::stoull(value());
+        else if (arg == "--seed") seed = std::stoull(value());
+        else if (arg == "--max-ops") maxOps = std::stoull(value());
+        else if (arg == "--ops") ops = std::stoull(value());
+        else if (arg == "--samples") samples = std::stoull(value());
+        else if (arg == "--tolerance") tolerance = std::stod(value());
+        else if (arg == "--profile") profile = value();
+        else if (arg == "--baseline") baseline = value();
+        else if (arg == "--write-baseline") writeBaseline = value();
+        else if (arg == "--record") {
+            mode = "record";
+            record = value();
+        } else if (arg == "--replay" || arg == "--trace" || arg == "--perf") mode = arg.substr(2);
+        else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "unknown argument: " << arg << "\n";
+            return 2;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    std::mt19937_64 rng(seed);
+    if (mode == "random") {
+        for (size_t it = 0; it < iterations; ++it) {
+            std::vector<uint8_t> input(1 + 3 * (rng() % (maxOps + 1)));
+            for (auto& b : input) b = static_cast<uint8_t>(rng());
+            LLVMFuzzerTestOneInput(input.data(), input.size());
+        }
+        std::cerr << "list_fuzz: " << iterations << " random inputs ok\n";
+    } else if (mode == "replay") {
+        for (const auto& path : files) {
+            std::vector<uint8_t> input = readFile(path);
+            LLVMFuzzerTestOneInput(input.data(), input.size());
+        }
+        std::cerr << "list_fuzz: " << files.size() << " inputs ok\n";
+    } else if (mode == "trace") {
+        for (const auto& path : files) {
+            runChecked(loadTrace(path), false);
+            runChecked(loadTrace(path), true);
+        }
+        std::cerr << "list_fuzz: " << files.size() << " traces ok\n";
+    } else if (mode == "record") {
+        std::vector<unsigned> weights = profileWeights(profile);
+        std::discrete_distribution<unsigned> pickOp(weights.begin(), weights.end());
+        std::ofstream out(record);
+        if (!out) throw std::runtime_error("cannot write " + record);
+        out << "# list_fuzz trace: profile " << profile << ", seed " << seed << "\n";
+        for (size_t i = 0; i < ops; ++i) {
+            Op op;
+            op.code = static_cast<uint8_t>(pickOp(rng));
+            op.value = static_cast<int>(rng() % kValueRange);
+            op.index = static_cast<uint32_t>(rng() % 65536);
+            writeOp(out, op);
+        }
+    } else if (mode == "perf") {
+        return runPerf(files, samples ? samples : 1, baseline, tolerance, writeBaseline);
+    }
+    return 0;
+}
+
+#endif